@@ -0,0 +1,4 @@
+#pragma once
+#include <cstddef>
+
+size_t allocationCount();
\ No newline at end of file
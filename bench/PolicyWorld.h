@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Particle.h"
+#include "Integrators.h"
+#include "ThreadPool.h"
+
+template <typename Integrator, typename Field = UniformField>
+class PolicyWorld {
+private:
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> velocityX;
+    std::vector<float> velocityY;
+    std::vector<float> masses;
+    std::vector<float> mobility;
+    Field field;
+    
+public:
+    explicit PolicyWorld(const Field& field = Field()) : field(field) {}
+    
+    size_t addParticle(const Particle& particle) {
+        bool movable = !particle.hasInfiniteMass();
+        positionX.push_back(particle.position.x);
+        positionY.push_back(particle.position.y);
+        velocityX.push_back(movable ? particle.velocity.x : 0.0f);
+        velocityY.push_back(movable ? particle.velocity.y : 0.0f);
+        masses.push_back(movable ? particle.getMass() : 0.0f);
+        mobility.push_back(movable ? 1.0f : 0.0f);
+        return positionX.size() - 1;
+    }
+    
+    void clear() {
+        positionX.clear();
+        positionY.clear();
+        velocityX.clear();
+        velocityY.clear();
+        masses.clear();
+        mobility.clear();
+    }
+    
+    void integrate(size_t begin, size_t end, float dt) {
+        float* x = positionX.data();
+        float* y = positionY.data();
+        float* vx = velocityX.data();
+        float* vy = velocityY.data();
+        const float* active = mobility.data();
+        const Field local = field;
+        
+        for (size_t i = begin; i < end; i++) {
+            Integrator::step(x[i], y[i], vx[i], vy[i], local, dt * active[i]);
+        }
+    }
+    
+    void update(float dt, ThreadPool& pool) {
+        pool.parallelFor(size(), 4096, [this, dt](size_t begin, size_t end) {
+            integrate(begin, end, dt);
+        });
+    }
+    
+    double kineticEnergy() const {
+        double energy = 0.0;
+        for (size_t i = 0; i < size(); i++) {
+            energy += 0.5 * masses[i] * (velocityX[i] * velocityX[i] + velocityY[i] * velocityY[i]);
+        }
+        return energy;
+    }
+    
+    double potentialEnergy() const {
+        double energy = 0.0;
+        for (size_t i = 0; i < size(); i++) {
+            energy += masses[i] * field.potential(positionX[i], positionY[i]);
+        }
+        return energy;
+    }
+    
+    double totalEnergy() const { return kineticEnergy() + potentialEnergy(); }
+    
+    size_t size() const { return positionX.size(); }
+    Vector2 getPosition(size_t i) const { return Vector2(positionX[i], positionY[i]); }
+    Vector2 getVelocity(size_t i) const { return Vector2(velocityX[i], velocityY[i]); }
+    Field& getField() { return field; }
+    
+    static std::string getIntegratorName() { return Integrator::name(); }
+};
\ No newline at end of file
@@ -0,0 +1,832 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include "AllocationCounter.h"
+#include "Vector2.h"
+#include "Particle.h"
+#include "RigidBody.h"
+#include "Collision.h"
+#include "CollisionResolver.h"
+#include "Constraint.h"
+#include "PhysicsWorld.h"
+#include "QuantizedParticles.h"
+#include "RigidBodyWorld.h"
+#include "StaticColliders.h"
+#include "HierarchicalGrid.h"
+#include "GridPairCache.h"
+#include "WorldEnsemble.h"
+#include "PolicyWorld.h"
+#include "ContactEvents.h"
+
+template <typename T>
+static inline void doNotOptimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+static inline uint64_t readCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+class CacheMissCounter {
+private:
+    int fd;
+    
+public:
+    CacheMissCounter() : fd(-1) {
+#if defined(__linux__)
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+    
+    ~CacheMissCounter() {
+#if defined(__linux__)
+        if (fd >= 0) close(fd);
+#endif
+    }
+    
+    bool available() const { return fd >= 0; }
+    
+    void start() {
+#if defined(__linux__)
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+    
+    uint64_t stop() {
+        uint64_t count = 0;
+#if defined(__linux__)
+        if (fd < 0) return 0;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != sizeof(count)) count = 0;
+#endif
+        return count;
+    }
+};
+
+static CacheMissCounter& cacheMisses() {
+    static CacheMissCounter counter;
+    return counter;
+}
+
+struct Benchmark {
+    std::string name;
+    std::function<void()> setup;
+    std::function<size_t()> run;
+    std::function<double()> energyDrift;
+};
+
+struct BenchResult {
+    std::string name;
+    double cyclesPerOp;
+    double nsPerOp;
+    double allocsPerOp;
+    double cacheMissesPerOp;
+    double energyDrift;
+};
+
+static std::vector<Benchmark>& registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+static void addBenchmark(const std::string& name, std::function<void()> setup, std::function<size_t()> run,
+                         std::function<double()> energyDrift = nullptr) {
+    registry().push_back({ name, std::move(setup), std::move(run), std::move(energyDrift) });
+}
+
+static BenchResult measure(const Benchmark& bench, int repetitions) {
+    using Clock = std::chrono::steady_clock;
+    
+    bench.setup();
+    bench.run();
+    
+    size_t batches = 1;
+    for (;;) {
+        bench.setup();
+        auto start = Clock::now();
+        for (size_t i = 0; i < batches; i++) bench.run();
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        if (elapsed > 0.002 || batches > (1u << 20)) break;
+        batches *= 2;
+    }
+    
+    std::vector<double> cycles, nanos, allocs, misses;
+    for (int r = 0; r < repetitions; r++) {
+        bench.setup();
+        size_t ops = 0;
+        size_t allocStart = allocationCount();
+        cacheMisses().start();
+        uint64_t cycleStart = readCycles();
+        auto start = Clock::now();
+        for (size_t i = 0; i < batches; i++) ops += bench.run();
+        auto end = Clock::now();
+        uint64_t cycleEnd = readCycles();
+        uint64_t missCount = cacheMisses().stop();
+        size_t allocEnd = allocationCount();
+        
+        double n = static_cast<double>(std::max<size_t>(ops, 1));
+        cycles.push_back((cycleEnd - cycleStart) / n);
+        nanos.push_back(std::chrono::duration<double, std::nano>(end - start).count() / n);
+        allocs.push_back((allocEnd - allocStart) / n);
+        misses.push_back(cacheMisses().available() ? missCount / n : -1.0);
+    }
+    
+    auto median = [](std::vector<double>& v) {
+        std::sort(v.begin(), v.end());
+        return v[v.size() / 2];
+    };
+    double drift = bench.energyDrift ? bench.energyDrift() : -1.0;
+    return { bench.name, median(cycles), median(nanos), median(allocs), median(misses), drift };
+}
+
+static void registerVectorBenchmarks() {
+    static std::vector<Vector2> a, b, out;
+    auto setup = [] {
+        std::mt19937 gen(1);
+        std::uniform_real_distribution<float> dist(-100, 100);
+        a.resize(1024); b.resize(1024); out.resize(1024);
+        for (size_t i = 0; i < a.size(); i++) {
+            a[i] = Vector2(dist(gen), dist(gen));
+            b[i] = Vector2(dist(gen), dist(gen));
+        }
+    };
+    
+    addBenchmark("Vector2::operator+", setup, [] {
+        for (size_t i = 0; i < a.size(); i++) out[i] = a[i] + b[i];
+        doNotOptimize(out[0]);
+        return a.size();
+    });
+    addBenchmark("Vector2::operator*", setup, [] {
+        for (size_t i = 0; i < a.size(); i++) out[i] = a[i] * 1.5f;
+        doNotOptimize(out[0]);
+        return a.size();
+    });
+    addBenchmark("Vector2::dot", setup, [] {
+        float sum = 0;
+        for (size_t i = 0; i < a.size(); i++) sum += a[i].dot(b[i]);
+        doNotOptimize(sum);
+        return a.size();
+    });
+    addBenchmark("Vector2::cross", setup, [] {
+        float sum = 0;
+        for (size_t i = 0; i < a.size(); i++) sum += a[i].cross(b[i]);
+        doNotOptimize(sum);
+        return a.size();
+    });
+    addBenchmark("Vector2::magnitude", setup, [] {
+        float sum = 0;
+        for (size_t i = 0; i < a.size(); i++) sum += a[i].magnitude();
+        doNotOptimize(sum);
+        return a.size();
+    });
+    addBenchmark("Vector2::normalize", setup, [] {
+        for (size_t i = 0; i < a.size(); i++) out[i] = a[i].normalize();
+        doNotOptimize(out[0]);
+        return a.size();
+    });
+    addBenchmark("Vector2::distance", setup, [] {
+        float sum = 0;
+        for (size_t i = 0; i < a.size(); i++) sum += Vector2::distance(a[i], b[i]);
+        doNotOptimize(sum);
+        return a.size();
+    });
+    addBenchmark("Vector2::rotate", setup, [] {
+        for (size_t i = 0; i < a.size(); i++) out[i] = Vector2::rotate(a[i], 0.3f);
+        doNotOptimize(out[0]);
+        return a.size();
+    });
+}
+
+static std::vector<Particle> makeParticles(size_t count, float extent, float radius, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(0, extent);
+    std::vector<Particle> particles;
+    particles.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        particles.emplace_back(Vector2(dist(gen), dist(gen)), 1.0f, radius);
+    }
+    return particles;
+}
+
+static void registerNarrowphaseBenchmarks() {
+    static std::vector<Particle> particles;
+    addBenchmark("CollisionDetector::generateContact",
+        [] { particles = makeParticles(256, 60, 5, 2); },
+        [] {
+            size_t ops = 0;
+            for (size_t i = 0; i + 1 < particles.size(); i += 2) {
+                Contact* contact = CollisionDetector::generateContact(particles[i], particles[i + 1]);
+                doNotOptimize(contact);
+                delete contact;
+                ops++;
+            }
+            return ops;
+        });
+    
+    static std::vector<RigidBody> circles, boxes;
+    auto rigidSetup = [] {
+        std::mt19937 gen(3);
+        std::uniform_real_distribution<float> dist(0, 40);
+        circles.clear();
+        boxes.clear();
+        for (int i = 0; i < 256; i++) {
+            circles.push_back(RigidBody::createCircle(Vector2(dist(gen), dist(gen)), 8, 1));
+            auto box = RigidBody::createBox(Vector2(dist(gen), dist(gen)), 16, 12, 1);
+            box.orientation = dist(gen);
+            boxes.push_back(box);
+        }
+    };
+    
+    addBenchmark("CollisionDetector::generateCircleBoxContact", rigidSetup, [] {
+        for (size_t i = 0; i < circles.size(); i++) {
+            RigidContact* contact = CollisionDetector::generateCircleBoxContact(circles[i], boxes[i]);
+            doNotOptimize(contact);
+            delete contact;
+        }
+        return circles.size();
+    });
+    addBenchmark("CollisionDetector::generateBoxBoxContact", rigidSetup, [] {
+        for (size_t i = 0; i + 1 < boxes.size(); i++) {
+            RigidContact* contact = CollisionDetector::generateBoxBoxContact(boxes[i], boxes[i + 1]);
+            doNotOptimize(contact);
+            delete contact;
+        }
+        return boxes.size() - 1;
+    });
+}
+
+static void registerGridBenchmarks() {
+    static std::vector<Particle> particles;
+    static std::unique_ptr<SpatialGrid> grid;
+    auto setup = [] {
+        particles = makeParticles(2000, 800, 4, 4);
+        grid = std::make_unique<SpatialGrid>(800, 800, 50);
+    };
+    
+    addBenchmark("SpatialGrid::insert", setup, [] {
+        grid->clear();
+        for (auto& particle : particles) grid->insert(particle);
+        return particles.size();
+    });
+    addBenchmark("SpatialGrid::query", [setup] {
+        setup();
+        for (auto& particle : particles) grid->insert(particle);
+    }, [] {
+        size_t found = 0;
+        for (auto& particle : particles) found += grid->query(particle).size();
+        doNotOptimize(found);
+        return particles.size();
+    });
+    
+    static std::vector<Particle> mixed;
+    static std::unique_ptr<HierarchicalGrid> hierarchical;
+    auto mixedSetup = [] {
+        mixed = makeParticles(20000, 1200, 2, 14);
+        std::mt19937 rng(15);
+        std::uniform_real_distribution<float> size(10.0f, 60.0f);
+        for (size_t i = 0; i < mixed.size(); i += 40) mixed[i].radius = size(rng);
+        grid = std::make_unique<SpatialGrid>(1200, 1200, 50);
+        hierarchical = std::make_unique<HierarchicalGrid>(1200.0f, 1200.0f);
+    };
+    addBenchmark("SpatialGrid::pairs/mixed-radii", mixedSetup, [] {
+        grid->clear();
+        for (auto& particle : mixed) grid->insert(particle);
+        std::vector<Particle*> nearby;
+        size_t found = 0;
+        for (auto& particle : mixed) {
+            grid->query(particle, nearby);
+            for (Particle* other : nearby) {
+                if (other > &particle && CollisionDetector::checkCollision(particle, *other)) found++;
+            }
+        }
+        doNotOptimize(found);
+        return mixed.size();
+    });
+    addBenchmark("HierarchicalGrid::pairs/mixed-radii", mixedSetup, [] {
+        hierarchical->build(mixed);
+        size_t found = 0;
+        for (uint32_t i = 0; i < mixed.size(); i++) {
+            hierarchical->forEachCandidate(mixed, i, [&](uint32_t j) {
+                if (CollisionDetector::checkCollision(mixed[i], mixed[j])) found++;
+            });
+        }
+        doNotOptimize(found);
+        return mixed.size();
+    });
+    
+    static std::vector<Particle> moving;
+    static std::vector<Vector2> displacements;
+    static std::unique_ptr<SpatialGrid> tracked;
+    static GridPairCache pairCache;
+    static int motionStep;
+    auto motionSetup = [](float amplitude) {
+        return [amplitude] {
+            moving = makeParticles(20000, 1200, 3, 16);
+            displacements.resize(moving.size());
+            std::mt19937 rng(17);
+            std::uniform_real_distribution<float> jitter(-amplitude, amplitude);
+            for (auto& d : displacements) d = Vector2(jitter(rng), jitter(rng));
+            grid = std::make_unique<SpatialGrid>(1200, 1200, 50);
+            tracked = std::make_unique<SpatialGrid>(1200, 1200, 50);
+            tracked->update(moving);
+            pairCache.invalidate();
+            pairCache.refresh(*tracked, moving);
+            motionStep = 0;
+        };
+    };
+    auto moveParticles = [] {
+        float sign = (motionStep++ % 2 == 0) ? 1.0f : -1.0f;
+        for (size_t i = 0; i < moving.size(); i++) {
+            moving[i].position += displacements[i] * sign;
+        }
+    };
+    auto rebuildPairs = [moveParticles] {
+        moveParticles();
+        grid->clear();
+        for (auto& particle : moving) grid->insert(particle);
+        std::vector<Particle*> nearby;
+        size_t found = 0;
+        for (auto& particle : moving) {
+            grid->query(particle, nearby);
+            for (Particle* other : nearby) {
+                if (other > &particle && CollisionDetector::checkCollision(particle, *other)) found++;
+            }
+        }
+        doNotOptimize(found);
+        return moving.size();
+    };
+    auto incrementalPairs = [moveParticles] {
+        moveParticles();
+        tracked->update(moving);
+        pairCache.refresh(*tracked, moving);
+        size_t found = 0;
+        pairCache.forEachPair([&](uint32_t a, uint32_t b) {
+            if (CollisionDetector::checkCollision(moving[a], moving[b])) found++;
+        });
+        doNotOptimize(found);
+        return moving.size();
+    };
+    const std::pair<const char*, float> regimes[] = { { "settled", 0.05f }, { "drifting", 2.0f }, { "chaotic", 30.0f } };
+    for (const auto& regime : regimes) {
+        addBenchmark(std::string("SpatialGrid::rebuild/") + regime.first, motionSetup(regime.second), rebuildPairs);
+        addBenchmark(std::string("SpatialGrid::incremental/") + regime.first, motionSetup(regime.second), incrementalPairs);
+    }
+    
+    static StaticColliders level;
+    addBenchmark("StaticColliders::queryCircle/20k-shapes", [] {
+        level.clear();
+        std::mt19937 rng(12);
+        std::uniform_real_distribution<float> coord(0.0f, 4000.0f);
+        for (int i = 0; i < 20000; i++) {
+            Vector2 c(coord(rng), coord(rng));
+            if (i % 2 == 0) {
+                level.addSegment(c, c + Vector2(30, 10), 2.0f);
+            } else {
+                level.addBox(c, 20, 10, i * 0.1f);
+            }
+        }
+        level.build();
+        particles = makeParticles(2000, 4000, 8, 13);
+    }, [] {
+        size_t hits = 0;
+        for (auto& particle : particles) {
+            level.queryCircle(particle.position, particle.radius, [&](const StaticContact&) { hits++; });
+        }
+        doNotOptimize(hits);
+        return particles.size();
+    });
+}
+
+static void registerResolverBenchmarks() {
+    static std::vector<Particle> particles, initial;
+    static std::vector<Contact> contacts;
+    static CollisionResolver resolver(0.7f);
+    
+    addBenchmark("CollisionResolver::resolveContact", [] {
+        initial.clear();
+        std::mt19937 gen(5);
+        std::uniform_real_distribution<float> dist(-1, 1);
+        for (int i = 0; i < 512; i++) {
+            Particle a(Vector2(0, 0), 1.0f, 5);
+            Particle b(Vector2(8 + dist(gen), dist(gen)), 2.0f, 5);
+            a.velocity = Vector2(10, dist(gen));
+            b.velocity = Vector2(-10, dist(gen));
+            initial.push_back(a);
+            initial.push_back(b);
+        }
+        particles = initial;
+        contacts.clear();
+        for (size_t i = 0; i < particles.size(); i += 2) {
+            Contact* contact = CollisionDetector::generateContact(particles[i], particles[i + 1]);
+            contacts.push_back(*contact);
+            delete contact;
+        }
+    }, [] {
+        std::copy(initial.begin(), initial.end(), particles.begin());
+        for (auto& contact : contacts) resolver.resolveContact(contact);
+        return contacts.size();
+    });
+}
+
+static void registerConstraintBenchmarks() {
+    static std::vector<Particle> particles;
+    static std::vector<SpringConstraint> springs;
+    static std::vector<DistanceConstraint> distances;
+    static std::vector<PinConstraint> pins;
+    static std::vector<AngleConstraint> angles;
+    
+    auto setup = [] {
+        particles = makeParticles(1025, 400, 3, 6);
+        springs.clear();
+        distances.clear();
+        pins.clear();
+        angles.clear();
+        for (size_t i = 0; i + 1 < particles.size(); i++) {
+            springs.emplace_back(&particles[i], &particles[i + 1], 10.0f, 50.0f);
+            distances.emplace_back(&particles[i], &particles[i + 1], 10.0f);
+            pins.emplace_back(&particles[i], particles[i].position, 0.5f);
+        }
+        for (size_t i = 0; i + 2 < particles.size(); i++) {
+            angles.emplace_back(&particles[i], &particles[i + 1], &particles[i + 2], 3.0f);
+        }
+    };
+    
+    addBenchmark("SpringConstraint::solve", setup, [] {
+        for (auto& c : springs) c.solve();
+        for (auto& p : particles) p.clearForces();
+        return springs.size();
+    });
+    addBenchmark("DistanceConstraint::solve", setup, [] {
+        for (auto& c : distances) c.solve();
+        return distances.size();
+    });
+    addBenchmark("PinConstraint::solve", setup, [] {
+        for (auto& c : pins) c.solve();
+        return pins.size();
+    });
+    addBenchmark("AngleConstraint::solve", setup, [] {
+        for (auto& c : angles) c.solve();
+        return angles.size();
+    });
+}
+
+static void registerParticleBenchmarks() {
+    static std::vector<Particle> particles;
+    static QuantizedParticles quantized;
+    auto setup = [] {
+        particles = makeParticles(100000, 1000, 3, 9);
+        for (size_t i = 0; i < particles.size(); i++) {
+            particles[i].velocity = Vector2(static_cast<float>(i % 200) - 100.0f, 50.0f);
+        }
+    };
+    
+    addBenchmark("Particle::integrate", setup, [] {
+        for (auto& particle : particles) {
+            particle.addForce(Vector2(0, 200));
+            particle.integrate(1.0f / 60.0f);
+        }
+        doNotOptimize(particles[0].position);
+        return particles.size();
+    });
+    addBenchmark("QuantizedParticles::encode", setup, [] {
+        quantized.encode(particles, Vector2(0, 0), Vector2(1000, 1000), 500.0f, ThreadPool::global());
+        doNotOptimize(quantized.getData()[0]);
+        return particles.size();
+    });
+}
+
+static void registerRigidBenchmarks() {
+    static std::vector<RigidBody> bodies;
+    static std::unique_ptr<RigidBodyWorld> world;
+    auto setup = [] {
+        std::mt19937 gen(11);
+        std::uniform_real_distribution<float> dist(0, 1000);
+        bodies.clear();
+        world = std::make_unique<RigidBodyWorld>(1000, 1000);
+        for (int i = 0; i < 50000; i++) {
+            RigidBody body = i % 2 == 0
+                ? RigidBody::createCircle(Vector2(dist(gen), dist(gen)), 5.0f, 1.0f)
+                : RigidBody::createBox(Vector2(dist(gen), dist(gen)), 8.0f, 8.0f, 2.0f);
+            body.angularVelocity = 1.0f;
+            bodies.push_back(body);
+            world->addBody(body);
+        }
+    };
+    
+    addBenchmark("RigidBody::integrate/aos", setup, [] {
+        for (auto& body : bodies) {
+            body.addForce(Vector2(0, 400) * body.mass);
+            body.integrate(1.0f / 600.0f);
+        }
+        doNotOptimize(bodies[0].position);
+        return bodies.size();
+    });
+    addBenchmark("RigidBodyWorld::integrate/soa", setup, [] {
+        world->integrate(0, world->size(), 1.0f / 600.0f);
+        doNotOptimize(world->getPositions()[0]);
+        return world->size();
+    });
+    
+    static std::unique_ptr<ContactEvents> events;
+    static std::vector<BodyPair> pairs;
+    static std::vector<uint8_t> flags;
+    addBenchmark("ContactEvents::endStep/20k-pairs", [] {
+        std::mt19937 gen(13);
+        std::uniform_int_distribution<uint32_t> body(0, 9999);
+        events = std::make_unique<ContactEvents>();
+        flags.assign(10000, CONTACT_EVENTS_BEGIN | CONTACT_EVENTS_END);
+        pairs.resize(20000);
+        for (auto& pair : pairs) pair = { body(gen), body(gen) };
+        for (const auto& pair : pairs) events->record(pair.a, pair.b, Vector2(), Vector2(0, 1), 0.1f);
+        events->endStep(flags.data());
+    }, [] {
+        for (size_t i = 0; i < pairs.size(); i++) {
+            if (i % 10 == 0) continue;
+            events->record(pairs[i].b, pairs[i].a, Vector2(), Vector2(0, 1), 0.1f);
+        }
+        events->endStep(flags.data());
+        doNotOptimize(events->getEvents().size());
+        return pairs.size();
+    });
+}
+
+static void registerSceneBenchmarks() {
+    static std::unique_ptr<PhysicsWorld> world;
+    
+    auto makeScene = [](int reorderInterval) {
+        return [reorderInterval] {
+            world = std::make_unique<PhysicsWorld>(1600, 1200);
+            world->setCollisionsEnabled(true);
+            world->setReorderInterval(reorderInterval);
+            world->addForceGenerator(std::make_shared<GravityForce>(Vector2(0, 200)));
+            
+            std::vector<Particle> particles = makeParticles(20000, 1200, 3, 7);
+            std::shuffle(particles.begin(), particles.end(), std::mt19937(8));
+            for (const auto& particle : particles) world->addParticle(particle);
+            for (int i = 0; i < 20; i++) world->update(1.0f / 60.0f);
+        };
+    };
+    auto step = [] {
+        world->update(1.0f / 60.0f);
+        return size_t(1);
+    };
+    
+    static std::unique_ptr<WorldEnsemble> ensemble;
+    addBenchmark("WorldEnsemble::step/256x64", [] {
+        ensemble = std::make_unique<WorldEnsemble>();
+        ensemble->addSharedForceGenerator(std::make_shared<GravityForce>(Vector2(0, 200)));
+        for (int k = 0; k < 256; k++) {
+            PhysicsWorld& small = ensemble->addWorld(400, 300);
+            small.setCollisionsEnabled(true);
+            small.setRestitution(0.2f + 0.002f * k);
+            for (const auto& particle : makeParticles(64, 300, 4, k)) small.addParticle(particle);
+        }
+    }, [] {
+        ensemble->step(1.0f / 60.0f, 1, ThreadPool::global());
+        return ensemble->size();
+    });
+    
+    auto makeProjectileScene = [](bool adaptive) {
+        return [adaptive] {
+            world = std::make_unique<PhysicsWorld>(1600, 1200);
+            world->setAdaptiveTimestep(adaptive);
+            world->addForceGenerator(std::make_shared<GravityForce>(Vector2(0, 200)));
+            for (const auto& particle : makeParticles(20000, 1200, 3, 11)) world->addParticle(particle);
+            for (int i = 0; i < 16; i++) {
+                Particle projectile(Vector2(100.0f + 60.0f * i, 600.0f), 1.0f, 3.0f);
+                projectile.velocity = Vector2(3000.0f, -500.0f);
+                world->addParticle(projectile);
+            }
+        };
+    };
+    addBenchmark("PhysicsWorld::update/projectiles-fixed16", makeProjectileScene(false), [] {
+        for (int i = 0; i < 16; i++) world->update(1.0f / 960.0f);
+        return size_t(1);
+    });
+    addBenchmark("PhysicsWorld::update/projectiles-adaptive", makeProjectileScene(true), step);
+    
+    addBenchmark("PhysicsWorld::update/shuffled", makeScene(0), step);
+    addBenchmark("PhysicsWorld::update/morton-reorder", makeScene(10), step);
+}
+
+template <typename Integrator>
+static void addIntegratorBenchmark() {
+    using World = PolicyWorld<Integrator, HarmonicField>;
+    static std::unique_ptr<World> world;
+    
+    auto populate = [](World& target, size_t count) {
+        std::mt19937 gen(21);
+        std::uniform_real_distribution<float> offset(-200, 200);
+        std::uniform_real_distribution<float> mass(0.5f, 4.0f);
+        for (size_t i = 0; i < count; i++) {
+            Particle particle(Vector2(offset(gen), offset(gen)), mass(gen), 3.0f);
+            particle.velocity = Vector2(offset(gen), offset(gen));
+            target.addParticle(particle);
+        }
+    };
+    
+    addBenchmark("PolicyWorld::integrate/" + World::getIntegratorName(), [populate] {
+        world = std::make_unique<World>(HarmonicField(0.0f, 0.0f, 16.0f));
+        populate(*world, 65536);
+    }, [] {
+        world->integrate(0, world->size(), 1.0f / 240.0f);
+        doNotOptimize(world->getPosition(0));
+        return world->size();
+    }, [populate] {
+        World probe(HarmonicField(0.0f, 0.0f, 16.0f));
+        populate(probe, 256);
+        double initial = probe.totalEnergy();
+        for (int i = 0; i < 2400; i++) probe.integrate(0, probe.size(), 1.0f / 240.0f);
+        return std::abs(probe.totalEnergy() - initial) / initial;
+    });
+    
+    static std::unique_ptr<PhysicsWorld> particles;
+    addBenchmark("PhysicsWorld::integrateWith/" + Integrator::name(), [] {
+        particles = std::make_unique<PhysicsWorld>(1000, 1000);
+        particles->setIntegrator<Integrator>();
+        std::mt19937 gen(21);
+        std::uniform_real_distribution<float> dist(0, 1000);
+        for (int i = 0; i < 65536; i++) {
+            particles->addParticle(Particle(Vector2(dist(gen), dist(gen)), 1.0f, 3.0f));
+        }
+    }, [] {
+        particles->integrate(0, particles->getParticles().size(), 1.0f / 240.0f);
+        doNotOptimize(particles->getParticles()[0].position);
+        return particles->getParticles().size();
+    });
+    
+    static std::unique_ptr<RigidBodyWorld> rigid;
+    addBenchmark("RigidBodyWorld::integrateWith/" + Integrator::name(), [] {
+        std::mt19937 gen(11);
+        std::uniform_real_distribution<float> dist(0, 1000);
+        rigid = std::make_unique<RigidBodyWorld>(1000, 1000);
+        for (int i = 0; i < 50000; i++) {
+            RigidBody body = RigidBody::createCircle(Vector2(dist(gen), dist(gen)), 5.0f, 1.0f);
+            body.angularVelocity = 1.0f;
+            rigid->addBody(body);
+        }
+    }, [] {
+        rigid->integrateWith<Integrator>(0, rigid->size(), 1.0f / 600.0f);
+        doNotOptimize(rigid->getPositions()[0]);
+        return rigid->size();
+    });
+}
+
+static void registerIntegratorBenchmarks() {
+    addIntegratorBenchmark<SymplecticEuler>();
+    addIntegratorBenchmark<VelocityVerlet>();
+    addIntegratorBenchmark<RK4>();
+    addIntegratorBenchmark<Damped<SymplecticEuler>>();
+    addIntegratorBenchmark<Damped<VelocityVerlet>>();
+}
+
+static std::string resultToJson(const BenchResult& r) {
+    char buffer[512];
+    int length = std::snprintf(buffer, sizeof(buffer),
+        "{\"name\": \"%s\", \"cycles_per_op\": %.3f, \"ns_per_op\": %.3f, \"allocs_per_op\": %.4f, "
+        "\"cache_misses_per_op\": %.3f",
+        r.name.c_str(), r.cyclesPerOp, r.nsPerOp, r.allocsPerOp, r.cacheMissesPerOp);
+    std::string json(buffer, std::min<size_t>(std::max(length, 0), sizeof(buffer) - 1));
+    if (r.energyDrift >= 0.0) {
+        std::snprintf(buffer, sizeof(buffer), ", \"energy_drift\": %.6e", r.energyDrift);
+        json += buffer;
+    }
+    return json + "}";
+}
+
+static bool readNumber(const std::string& line, const std::string& key, double& value) {
+    size_t pos = line.find("\"" + key + "\"");
+    if (pos == std::string::npos) return false;
+    pos = line.find(':', pos);
+    if (pos == std::string::npos) return false;
+    value = std::strtod(line.c_str() + pos + 1, nullptr);
+    return true;
+}
+
+static std::map<std::string, BenchResult> loadBaseline(const std::string& path) {
+    std::map<std::string, BenchResult> baseline;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t nameKey = line.find("\"name\"");
+        if (nameKey == std::string::npos) continue;
+        size_t start = line.find('"', line.find(':', nameKey)) + 1;
+        size_t end = line.find('"', start);
+        
+        BenchResult r{ line.substr(start, end - start), 0, 0, 0, -1, -1 };
+        readNumber(line, "cycles_per_op", r.cyclesPerOp);
+        readNumber(line, "ns_per_op", r.nsPerOp);
+        readNumber(line, "allocs_per_op", r.allocsPerOp);
+        readNumber(line, "cache_misses_per_op", r.cacheMissesPerOp);
+        readNumber(line, "energy_drift", r.energyDrift);
+        baseline[r.name] = r;
+    }
+    return baseline;
+}
+
+int main(int argc, char** argv) {
+    std::string outPath, comparePath, filter;
+    double threshold = 10.0;
+    int repetitions = 9;
+    
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--out" && i + 1 < argc) outPath = argv[++i];
+        else if (arg == "--compare" && i + 1 < argc) comparePath = argv[++i];
+        else if (arg == "--threshold" && i + 1 < argc) threshold = std::atof(argv[++i]);
+        else if (arg == "--filter" && i + 1 < argc) filter = argv[++i];
+        else if (arg == "--repetitions" && i + 1 < argc) repetitions = std::max(1, std::atoi(argv[++i]));
+        else {
+            std::fprintf(stderr, "usage: %s [--out file.json] [--compare baseline.json] "
+                         "[--threshold percent] [--filter substring] [--repetitions n]\n", argv[0]);
+            return 2;
+        }
+    }
+    
+    registerVectorBenchmarks();
+    registerNarrowphaseBenchmarks();
+    registerGridBenchmarks();
+    registerResolverBenchmarks();
+    registerConstraintBenchmarks();
+    registerParticleBenchmarks();
+    registerRigidBenchmarks();
+    registerSceneBenchmarks();
+    registerIntegratorBenchmarks();
+    
+    std::vector<BenchResult> results;
+    for (const auto& bench : registry()) {
+        if (!filter.empty() && bench.name.find(filter) == std::string::npos) continue;
+        results.push_back(measure(bench, repetitions));
+    }
+    
+    std::ostringstream json;
+    json << "{\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        json << "    " << resultToJson(results[i]) << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    json << "  ]\n}\n";
+    
+    if (outPath.empty()) {
+        std::fputs(json.str().c_str(), stdout);
+    } else {
+        std::ofstream(outPath) << json.str();
+    }
+    
+    if (comparePath.empty()) return 0;
+    
+    auto baseline = loadBaseline(comparePath);
+    int regressions = 0;
+    for (const auto& r : results) {
+        auto it = baseline.find(r.name);
+        if (it == baseline.end()) continue;
+        
+        const BenchResult& base = it->second;
+        bool useCycles = r.cyclesPerOp > 0 && base.cyclesPerOp > 0;
+        double before = useCycles ? base.cyclesPerOp : base.nsPerOp;
+        double after = useCycles ? r.cyclesPerOp : r.nsPerOp;
+        double change = before > 0 ? (after - before) / before * 100.0 : 0.0;
+        bool slower = change > threshold;
+        bool moreAllocs = r.allocsPerOp > base.allocsPerOp + 1e-3;
+        
+        std::fprintf(stderr, "%-45s %10.2f -> %10.2f %s (%+.1f%%)%s%s\n",
+                     r.name.c_str(), before, after, useCycles ? "cyc" : "ns ", change,
+                     slower ? "  REGRESSION" : "", moreAllocs ? "  MORE-ALLOCS" : "");
+        if (slower || moreAllocs) regressions++;
+    }
+    
+    return regressions > 0 ? 1 : 0;
+}
\ No newline at end of file
@@ -6,7 +6,10 @@
 #include "RigidBody.h"
 #include "Renderer.h"
 #include "Collision.h"
-#include "RigidBodyResolver.h"
+#include "RigidBodyWorld.h"
+#include "TaskGraph.h"
+#include "SceneFile.h"
+#include "SharedState.h"
 
 enum class DemoMode {
     SANDBOX,           
@@ -17,7 +20,7 @@ enum class DemoMode {
     EXPLOSION         
 };
 
-void spawnCircleFountain(std::vector<RigidBody>& bodies, const Vector2& pos, int count) {
+void spawnCircleFountain(RigidBodyWorld& world, const Vector2& pos, int count) {
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_real_distribution<float> angleDist(0, 2 * M_PI);
@@ -33,11 +36,11 @@ void spawnCircleFountain(std::vector<RigidBody>& bodies, const Vector2& pos, int
         circle.velocity = Vector2(std::cos(angle), std::sin(angle)) * speed;
         circle.restitution = 0.6f;
         circle.friction = 0.3f;
-        bodies.push_back(circle);
+        world.addBody(circle);
     }
 }
 
-void spawnBoxTower(std::vector<RigidBody>& bodies, const Vector2& basePos, int height, float boxSize) {
+void spawnBoxTower(RigidBodyWorld& world, const Vector2& basePos, int height, float boxSize) {
     for (int i = 0; i < height; i++) {
         auto box = RigidBody::createBox(
             Vector2(basePos.x, basePos.y - i * (boxSize + 2)), 
@@ -45,11 +48,11 @@ void spawnBoxTower(std::vector<RigidBody>& bodies, const Vector2& basePos, int h
         );
         box.restitution = 0.3f;
         box.friction = 0.6f;
-        bodies.push_back(box);
+        world.addBody(box);
     }
 }
 
-void spawnPoolTable(std::vector<RigidBody>& bodies, const Vector2& center) {
+void spawnPoolTable(RigidBodyWorld& world, const Vector2& center) {
     float radius = 12.0f;
     float spacing = radius * 2.2f;
     
@@ -61,7 +64,7 @@ void spawnPoolTable(std::vector<RigidBody>& bodies, const Vector2& center) {
             auto ball = RigidBody::createCircle(Vector2(x, y), radius, 1.0f);
             ball.restitution = 0.9f; 
             ball.friction = 0.1f;      
-            bodies.push_back(ball);
+            world.addBody(ball);
         }
     }
     
@@ -69,10 +72,10 @@ void spawnPoolTable(std::vector<RigidBody>& bodies, const Vector2& center) {
     cueBall.restitution = 0.9f;
     cueBall.friction = 0.1f;
     cueBall.velocity = Vector2(0, -400);  
-    bodies.push_back(cueBall);
+    world.addBody(cueBall);
 }
 
-void spawnNewtonCradle(std::vector<RigidBody>& bodies, const Vector2& center, int count) {
+void spawnNewtonCradle(RigidBodyWorld& world, const Vector2& center, int count) {
     float radius = 15.0f;
     float spacing = radius * 2.1f;
     
@@ -81,15 +84,14 @@ void spawnNewtonCradle(std::vector<RigidBody>& bodies, const Vector2& center, in
         auto ball = RigidBody::createCircle(Vector2(x, center.y), radius, 1.0f);
         ball.restitution = 0.99f; 
         ball.friction = 0.0f;
-        bodies.push_back(ball);
-    }
-    
-    if (!bodies.empty()) {
-        bodies[bodies.size() - count].velocity = Vector2(200, 0);
+        if (i == 0) {
+            ball.velocity = Vector2(200, 0);
+        }
+        world.addBody(ball);
     }
 }
 
-void spawnExplosion(std::vector<RigidBody>& bodies, const Vector2& center, int count) {
+void spawnExplosion(RigidBodyWorld& world, const Vector2& center, int count) {
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_real_distribution<float> angleDist(0, 2 * M_PI);
@@ -107,26 +109,78 @@ void spawnExplosion(std::vector<RigidBody>& bodies, const Vector2& center, int c
             circle.angularVelocity = (rand() % 100 - 50) * 0.1f;
             circle.restitution = 0.7f;
             circle.friction = 0.4f;
-            bodies.push_back(circle);
+            world.addBody(circle);
         } else {
             auto box = RigidBody::createBox(center, size, size, 2.0f);
             box.velocity = Vector2(std::cos(angle), std::sin(angle)) * speed;
             box.angularVelocity = (rand() % 100 - 50) * 0.1f;
             box.restitution = 0.7f;
             box.friction = 0.4f;
-            bodies.push_back(box);
+            world.addBody(box);
         }
     }
 }
 
-int main() {
+int main(int argc, char** argv) {
     const int SCREEN_WIDTH = 800;
     const int SCREEN_HEIGHT = 600;
     
     Renderer renderer(SCREEN_WIDTH, SCREEN_HEIGHT, "Physics Engine - Fun Demos!");
     
-    std::vector<RigidBody> bodies;
-    RigidBodyResolver resolver;
+    RigidBodyWorld world(SCREEN_WIDTH, SCREEN_HEIGHT);
+    world.getDetail().addInterestRect(Vector2(0, 0), Vector2(SCREEN_WIDTH, SCREEN_HEIGHT));
+    world.setDetailEnabled(true);
+    world.setContactEventsEnabled(true);
+    size_t impacts = 0;
+    world.getContactEvents().setListener([&impacts](const ContactEvent& event) {
+        if (event.phase == ContactPhase::BEGIN) impacts++;
+    });
+    ThreadPool& pool = ThreadPool::global();
+    TaskGraph graph;
+    
+    FrameGovernor governor(8.0);
+    world.registerKnobs(governor);
+    governor.setListener([](const GovernorAdjustment& a) {
+        std::cout << "Governor: " << a.knob << " " << a.from << " -> " << a.to << " (step "
+                  << a.stepMs << " ms, avg " << a.averageMs << " ms)" << std::endl;
+    });
+    
+    std::string scenePath;
+    std::string publishName;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--publish" && i + 1 < argc) {
+            publishName = argv[++i];
+        } else {
+            scenePath = arg;
+        }
+    }
+    
+    if (!scenePath.empty()) {
+        SceneFile scene;
+        std::string error;
+        if (scene.open(scenePath, error)) {
+            std::vector<RigidBody> bodies;
+            scene.loadRigidBodies(bodies);
+            for (const auto& body : bodies) {
+                world.addBody(body);
+            }
+            std::cout << "Loaded " << world.size() << " bodies from " << scenePath << std::endl;
+        } else {
+            std::cerr << scenePath << ": " << error << std::endl;
+        }
+    }
+    
+    SharedStatePublisher publisher;
+    if (!publishName.empty()) {
+        std::string error;
+        if (publisher.open(publishName, 0, 65536, 4, error)) {
+            std::cout << "Publishing state to shared memory " << publishName << std::endl;
+        } else {
+            std::cerr << error << std::endl;
+        }
+    }
+    double simulationTime = 0.0;
     
     std::random_device rd;
     std::mt19937 gen(rd());
@@ -136,7 +190,6 @@ int main() {
     sf::Clock clock;
     float spawnTimer = 0.0f;
     
-    Vector2 gravity(0, 400.0f);
     DemoMode currentMode = DemoMode::SANDBOX;
     bool autoSpawn = false;
     
@@ -153,10 +206,9 @@ int main() {
     std::cout << "  Mouse Click - Create explosion at cursor" << std::endl;
     std::cout << "  R - Clear all" << std::endl;
     std::cout << "  G - Toggle gravity" << std::endl;
+    std::cout << "  T - Print task timings" << std::endl;
     std::cout << "  ESC - Exit\n" << std::endl;
     
-    bool gravityEnabled = true;
-    
     auto& window = renderer.getWindow();
     
     while (window.isOpen()) {
@@ -180,36 +232,36 @@ int main() {
                 }
                 else if (event.key.code == sf::Keyboard::Num2) {
                     currentMode = DemoMode::CIRCLE_FOUNTAIN;
-                    bodies.clear();
+                    world.clear();
                     autoSpawn = true;
                     std::cout << "Mode: CIRCLE FOUNTAIN" << std::endl;
                 }
                 else if (event.key.code == sf::Keyboard::Num3) {
                     currentMode = DemoMode::BOX_TOWER;
-                    bodies.clear();
-                    spawnBoxTower(bodies, Vector2(400, 550), 12, 30);
+                    world.clear();
+                    spawnBoxTower(world, Vector2(400, 550), 12, 30);
                     autoSpawn = false;
                     std::cout << "Mode: BOX TOWER" << std::endl;
                 }
                 else if (event.key.code == sf::Keyboard::Num4) {
                     currentMode = DemoMode::POOL_TABLE;
-                    bodies.clear();
-                    spawnPoolTable(bodies, Vector2(400, 250));
+                    world.clear();
+                    spawnPoolTable(world, Vector2(400, 250));
                     autoSpawn = false;
                     std::cout << "Mode: POOL TABLE" << std::endl;
                 }
                 else if (event.key.code == sf::Keyboard::Num5) {
                     currentMode = DemoMode::NEWTON_CRADLE;
-                    bodies.clear();
-                    spawnNewtonCradle(bodies, Vector2(400, 300), 5);
+                    world.clear();
+                    spawnNewtonCradle(world, Vector2(400, 300), 5);
                     autoSpawn = false;
-                    gravityEnabled = false;
+                    world.setGravityEnabled(false);
                     std::cout << "Mode: NEWTON'S CRADLE (gravity off)" << std::endl;
                 }
                 else if (event.key.code == sf::Keyboard::Num6) {
                     currentMode = DemoMode::EXPLOSION;
-                    bodies.clear();
-                    spawnExplosion(bodies, Vector2(400, 300), 30);
+                    world.clear();
+                    spawnExplosion(world, Vector2(400, 300), 30);
                     autoSpawn = false;
                     std::cout << "Mode: EXPLOSION" << std::endl;
                 }
@@ -221,7 +273,7 @@ int main() {
                         box.restitution = 0.4f;
                         box.friction = 0.5f;
                         box.angularVelocity = (rand() % 100 - 50) * 0.02f;
-                        bodies.push_back(box);
+                        world.addBody(box);
                     }
                 }
                 else if (event.key.code == sf::Keyboard::C) {
@@ -231,125 +283,60 @@ int main() {
                         auto circle = RigidBody::createCircle(Vector2(x, 100), radius, 1.0f);
                         circle.restitution = 0.4f;
                         circle.friction = 0.5f;
-                        bodies.push_back(circle);
+                        world.addBody(circle);
                     }
                 }
                 else if (event.key.code == sf::Keyboard::R) {
-                    bodies.clear();
+                    world.clear();
                     std::cout << "Cleared all bodies" << std::endl;
                 }
                 else if (event.key.code == sf::Keyboard::G) {
-                    gravityEnabled = !gravityEnabled;
-                    std::cout << "Gravity: " << (gravityEnabled ? "ON" : "OFF") << std::endl;
+                    world.setGravityEnabled(!world.isGravityEnabled());
+                    std::cout << "Gravity: " << (world.isGravityEnabled() ? "ON" : "OFF") << std::endl;
+                }
+                else if (event.key.code == sf::Keyboard::T) {
+                    for (const TaskStats& stats : graph.getStats()) {
+                        std::cout << stats.name << ": " << stats.lastMs << " ms (avg "
+                                  << stats.averageMs << " ms over " << stats.runs << " runs)" << std::endl;
+                    }
+                    std::cout << "Step p99: " << governor.getP99() << " ms (budget "
+                              << governor.getBudget() << " ms)" << std::endl;
+                    std::cout << "Impacts: " << impacts << " (" << world.getContactEvents().getActivePairCount()
+                              << " pairs touching)" << std::endl;
                 }
             }
             
             if (event.type == sf::Event::MouseButtonPressed) {
                 if (event.mouseButton.button == sf::Mouse::Left) {
                     Vector2 mousePos = renderer.getMousePosition();
-                    spawnExplosion(bodies, mousePos, 20);
+                    spawnExplosion(world, mousePos, 20);
                     std::cout << "Explosion at mouse!" << std::endl;
                 }
             }
         }
         
-        if (autoSpawn && currentMode == DemoMode::CIRCLE_FOUNTAIN && bodies.size() < 50) {
+        if (autoSpawn && currentMode == DemoMode::CIRCLE_FOUNTAIN && world.size() < 50) {
             spawnTimer += dt;
             if (spawnTimer > 0.2f) {
-                spawnCircleFountain(bodies, Vector2(400, 50), 3);
+                spawnCircleFountain(world, Vector2(400, 50), 3);
                 spawnTimer = 0.0f;
             }
         }
         
-        if (gravityEnabled) {
-            for (auto& body : bodies) {
-                if (!body.hasInfiniteMass()) {
-                    body.addForce(gravity * body.mass);
-                }
-            }
-        }
+        governor.beginStep();
+        graph.clear();
+        world.buildStepGraph(graph, dt);
+        graph.run(pool);
+        governor.endStep();
+        world.getContactEvents().dispatch();
         
-        for (auto& body : bodies) {
-            body.integrate(dt);
-        }
-        
-        for (int iteration = 0; iteration < 2; iteration++) {
-            std::vector<RigidContact> contacts;
-            
-            for (size_t i = 0; i < bodies.size(); i++) {
-                for (size_t j = i + 1; j < bodies.size(); j++) {
-                    auto contact = CollisionDetector::generateRigidContact(bodies[i], bodies[j]);
-                    if (contact) {
-                        contacts.push_back(*contact);
-                        delete contact;
-                    }
-                }
-            }
-            
-            resolver.resolveContacts(contacts);
-        }
-        
-        for (auto& body : bodies) {
-            float restitution = 0.5f;
-            
-            if (body.shapeType == ShapeType::CIRCLE) {
-                if (body.position.y + body.radius > SCREEN_HEIGHT) {
-                    body.position.y = SCREEN_HEIGHT - body.radius;
-                    body.velocity.y *= -restitution;
-                    body.velocity.x *= 0.95f;
-                    body.angularVelocity *= 0.95f;
-                }
-                
-                if (body.position.y - body.radius < 0) {
-                    body.position.y = body.radius;
-                    body.velocity.y *= -restitution;
-                }
-                
-                if (body.position.x - body.radius < 0) {
-                    body.position.x = body.radius;
-                    body.velocity.x *= -restitution;
-                }
-                if (body.position.x + body.radius > SCREEN_WIDTH) {
-                    body.position.x = SCREEN_WIDTH - body.radius;
-                    body.velocity.x *= -restitution;
-                }
-            } else {
-                float maxRadius = std::max(body.width, body.height) * 0.7f;
-                
-                if (body.position.y + maxRadius > SCREEN_HEIGHT) {
-                    body.position.y = SCREEN_HEIGHT - maxRadius;
-                    body.velocity.y *= -restitution;
-                    body.velocity.x *= 0.95f;
-                    body.angularVelocity *= 0.95f;
-                }
-                
-                if (body.position.y - maxRadius < 0) {
-                    body.position.y = maxRadius;
-                    body.velocity.y *= -restitution;
-                }
-                
-                if (body.position.x - maxRadius < 0) {
-                    body.position.x = maxRadius;
-                    body.velocity.x *= -restitution;
-                }
-                if (body.position.x + maxRadius > SCREEN_WIDTH) {
-                    body.position.x = SCREEN_WIDTH - maxRadius;
-                    body.velocity.x *= -restitution;
-                }
-            }
-        }
-        
-        bodies.erase(
-            std::remove_if(bodies.begin(), bodies.end(),
-                [SCREEN_HEIGHT](const RigidBody& b) {
-                    return b.position.y > SCREEN_HEIGHT + 200;
-                }),
-            bodies.end()
-        );
+        simulationTime += dt;
+        publisher.publish(nullptr, &world, simulationTime);
         
         renderer.clear();
         
-        for (const auto& body : bodies) {
+        for (size_t i = 0; i < world.size(); i++) {
+            RigidBody body = world.getBody(i);
             sf::Color color;
             if (body.shapeType == ShapeType::CIRCLE) {
                 color = sf::Color(100, 150, 255);
@@ -0,0 +1,136 @@
+#include "AdaptiveTimestep.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+AdaptiveTimestep::AdaptiveTimestep(float courant, float minDt, float maxDt, int maxLevel)
+    : courant(courant), stiffnessFactor(0.5f), minDt(minDt), maxDt(maxDt), maxLevel(0),
+      activeLevels(1), particleOffsets(MAX_LEVELS + 1, 0), springOffsets(MAX_LEVELS + 1, 0) {
+    setMaxLevel(maxLevel);
+}
+
+uint32_t AdaptiveTimestep::findRoot(uint32_t i) {
+    while (parents[i] != i) {
+        parents[i] = parents[parents[i]];
+        i = parents[i];
+    }
+    return i;
+}
+
+float AdaptiveTimestep::plan(const std::vector<Particle>& particles,
+                             const std::vector<SpringConstraint>& springs, float remaining) {
+    const float unbounded = std::numeric_limits<float>::max();
+    const Particle* base = particles.data();
+    size_t count = particles.size();
+    
+    stableSteps.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        const Particle& p = particles[i];
+        float step = unbounded;
+        if (!p.hasInfiniteMass()) {
+            float speed = p.velocity.magnitude();
+            if (speed > 0.0f) step = courant * p.radius / speed;
+        }
+        stableSteps[i] = step;
+    }
+    
+    for (const auto& spring : springs) {
+        uint32_t a = static_cast<uint32_t>(spring.getParticleA() - base);
+        uint32_t b = static_cast<uint32_t>(spring.getParticleB() - base);
+        float w = particles[a].getInverseMass() + particles[b].getInverseMass();
+        float k = spring.getStiffness();
+        if (k <= 0.0f || w <= 0.0f) continue;
+        
+        float step = stiffnessFactor / std::sqrt(k * w);
+        stableSteps[a] = std::min(stableSteps[a], step);
+        stableSteps[b] = std::min(stableSteps[b], step);
+    }
+    
+    float fastest = unbounded;
+    for (size_t i = 0; i < count; i++) {
+        fastest = std::min(fastest, stableSteps[i]);
+    }
+    
+    float dt = std::min(maxDt, remaining);
+    if (fastest < unbounded) {
+        dt = std::min(dt, std::max(minDt, fastest * static_cast<float>(1 << maxLevel)));
+    }
+    if (remaining - dt < minDt) dt = remaining;
+    
+    levels.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        int level = 0;
+        float step = dt;
+        while (level < maxLevel && step > stableSteps[i]) {
+            step *= 0.5f;
+            level++;
+        }
+        levels[i] = static_cast<uint8_t>(level);
+    }
+    
+    if (!springs.empty()) {
+        parents.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            parents[i] = static_cast<uint32_t>(i);
+        }
+        for (const auto& spring : springs) {
+            const Particle* a = spring.getParticleA();
+            const Particle* b = spring.getParticleB();
+            if (a->hasInfiniteMass() || b->hasInfiniteMass()) continue;
+            uint32_t rootA = findRoot(static_cast<uint32_t>(a - base));
+            uint32_t rootB = findRoot(static_cast<uint32_t>(b - base));
+            if (rootA != rootB) parents[rootA] = rootB;
+        }
+        for (size_t i = 0; i < count; i++) {
+            uint32_t root = findRoot(static_cast<uint32_t>(i));
+            levels[root] = std::max(levels[root], levels[i]);
+        }
+        for (size_t i = 0; i < count; i++) {
+            levels[i] = levels[findRoot(static_cast<uint32_t>(i))];
+        }
+    }
+    
+    uint32_t cursor[MAX_LEVELS];
+    
+    std::fill(particleOffsets.begin(), particleOffsets.end(), 0);
+    for (size_t i = 0; i < count; i++) {
+        particleOffsets[levels[i] + 1]++;
+    }
+    activeLevels = 1;
+    for (int level = 0; level < MAX_LEVELS; level++) {
+        if (particleOffsets[level + 1] > 0) activeLevels = level + 1;
+        particleOffsets[level + 1] += particleOffsets[level];
+        cursor[level] = particleOffsets[level];
+    }
+    particleIndices.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        particleIndices[cursor[levels[i]]++] = static_cast<uint32_t>(i);
+    }
+    
+    std::fill(springOffsets.begin(), springOffsets.end(), 0);
+    for (const auto& spring : springs) {
+        const Particle* a = spring.getParticleA();
+        const Particle* owner = a->hasInfiniteMass() ? spring.getParticleB() : a;
+        springOffsets[levels[owner - base] + 1]++;
+    }
+    for (int level = 0; level < MAX_LEVELS; level++) {
+        springOffsets[level + 1] += springOffsets[level];
+        cursor[level] = springOffsets[level];
+    }
+    springIndices.resize(springs.size());
+    for (size_t i = 0; i < springs.size(); i++) {
+        const Particle* a = springs[i].getParticleA();
+        const Particle* owner = a->hasInfiniteMass() ? springs[i].getParticleB() : a;
+        springIndices[cursor[levels[owner - base]]++] = static_cast<uint32_t>(i);
+    }
+    
+    return dt;
+}
+
+size_t AdaptiveTimestep::getWorkUnits() const {
+    size_t work = 0;
+    for (int level = 0; level < activeLevels; level++) {
+        work += getLevelSize(level) << level;
+    }
+    return work;
+}
\ No newline at end of file
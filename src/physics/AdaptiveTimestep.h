@@ -0,0 +1,47 @@
+#pragma once
+#include "Particle.h"
+#include "Constraint.h"
+#include <vector>
+#include <cstdint>
+
+class AdaptiveTimestep {
+private:
+    float courant;
+    float stiffnessFactor;
+    float minDt;
+    float maxDt;
+    int maxLevel;
+    int activeLevels;
+    
+    std::vector<float> stableSteps;
+    std::vector<uint8_t> levels;
+    std::vector<uint32_t> parents;
+    std::vector<uint32_t> particleOffsets;
+    std::vector<uint32_t> particleIndices;
+    std::vector<uint32_t> springOffsets;
+    std::vector<uint32_t> springIndices;
+    
+    uint32_t findRoot(uint32_t i);
+    
+public:
+    static const int MAX_LEVELS = 8;
+    
+    AdaptiveTimestep(float courant = 0.5f, float minDt = 1.0f / 4000.0f,
+                     float maxDt = 1.0f / 60.0f, int maxLevel = 4);
+    
+    float plan(const std::vector<Particle>& particles, const std::vector<SpringConstraint>& springs,
+               float remaining);
+    
+    void setCourant(float c) { courant = c; }
+    void setStiffnessFactor(float f) { stiffnessFactor = f; }
+    void setStepLimits(float minStep, float maxStep) { minDt = minStep; maxDt = maxStep; }
+    void setMaxLevel(int level) { maxLevel = level < 0 ? 0 : (level >= MAX_LEVELS ? MAX_LEVELS - 1 : level); }
+    
+    int getActiveLevels() const { return activeLevels; }
+    uint8_t getLevel(size_t particle) const { return levels[particle]; }
+    size_t getLevelSize(int level) const { return particleOffsets[level + 1] - particleOffsets[level]; }
+    const uint32_t* getLevelParticles(int level) const { return particleIndices.data() + particleOffsets[level]; }
+    size_t getLevelSpringCount(int level) const { return springOffsets[level + 1] - springOffsets[level]; }
+    const uint32_t* getLevelSprings(int level) const { return springIndices.data() + springOffsets[level]; }
+    size_t getWorkUnits() const;
+};
\ No newline at end of file
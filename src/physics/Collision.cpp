@@ -91,10 +91,11 @@ std::vector<Contact> CollisionDetector::detectCollisionsBroadPhase(std::vector<P
 }
 
 SpatialGrid::SpatialGrid(int screenWidth, int screenHeight, int cellSize)
-    : cellSize(cellSize) {
+    : cellSize(cellSize), trackedBase(nullptr), trackedCount(0), movedCount(0) {
     gridWidth = (screenWidth / cellSize) + 1;
     gridHeight = (screenHeight / cellSize) + 1;
     grid.resize(gridWidth, std::vector<std::vector<Particle*>>(gridHeight));
+    cellDirty.assign(getCellCount(), 0);
 }
 
 void SpatialGrid::clear() {
@@ -103,6 +104,67 @@ void SpatialGrid::clear() {
             cell.clear();
         }
     }
+    trackedCount = 0;
+}
+
+void SpatialGrid::markDirty(int32_t cell) {
+    if (cellDirty[cell]) return;
+    cellDirty[cell] = 1;
+    dirtyCells.push_back(static_cast<uint32_t>(cell));
+}
+
+void SpatialGrid::track(Particle* particle, size_t index, int32_t cell) {
+    auto& members = grid[cell / gridHeight][cell % gridHeight];
+    particleCell[index] = cell;
+    particleSlot[index] = static_cast<uint32_t>(members.size());
+    members.push_back(particle);
+    markDirty(cell);
+}
+
+void SpatialGrid::update(std::vector<Particle>& particles) {
+    Particle* base = particles.data();
+    movedCount = 0;
+    
+    if (trackedCount == 0 || trackedBase != base || trackedCount != particles.size()) {
+        clear();
+        for (size_t cell = 0; cell < getCellCount(); cell++) {
+            markDirty(static_cast<int32_t>(cell));
+        }
+        particleCell.resize(particles.size());
+        particleSlot.resize(particles.size());
+        for (size_t i = 0; i < particles.size(); i++) {
+            int32_t cell = getGridX(particles[i].position.x) * gridHeight + getGridY(particles[i].position.y);
+            track(&particles[i], i, cell);
+        }
+        trackedBase = base;
+        trackedCount = particles.size();
+        movedCount = particles.size();
+        return;
+    }
+    
+    for (size_t i = 0; i < particles.size(); i++) {
+        int32_t cell = getGridX(particles[i].position.x) * gridHeight + getGridY(particles[i].position.y);
+        int32_t previous = particleCell[i];
+        if (cell == previous) continue;
+        
+        auto& members = grid[previous / gridHeight][previous % gridHeight];
+        uint32_t slot = particleSlot[i];
+        Particle* last = members.back();
+        members[slot] = last;
+        particleSlot[last - base] = slot;
+        members.pop_back();
+        markDirty(previous);
+        
+        track(&particles[i], i, cell);
+        movedCount++;
+    }
+}
+
+void SpatialGrid::clearDirty() {
+    for (uint32_t cell : dirtyCells) {
+        cellDirty[cell] = 0;
+    }
+    dirtyCells.clear();
 }
 
 int SpatialGrid::getGridX(float x) const {
@@ -123,6 +185,12 @@ void SpatialGrid::insert(Particle& particle) {
 
 std::vector<Particle*> SpatialGrid::query(const Particle& particle) {
     std::vector<Particle*> nearby;
+    query(particle, nearby);
+    return nearby;
+}
+
+void SpatialGrid::query(const Particle& particle, std::vector<Particle*>& out) const {
+    out.clear();
     
     int gx = getGridX(particle.position.x);
     int gy = getGridY(particle.position.y);
@@ -133,14 +201,11 @@ std::vector<Particle*> SpatialGrid::query(const Particle& particle) {
             int ny = gy + dy;
             
             if (nx >= 0 && nx < gridWidth && ny >= 0 && ny < gridHeight) {
-                for (auto* p : grid[nx][ny]) {
-                    nearby.push_back(p);
-                }
+                const auto& cell = grid[nx][ny];
+                out.insert(out.end(), cell.begin(), cell.end());
             }
         }
     }
-    
-    return nearby;
 }
 
 
@@ -159,28 +224,20 @@ bool CollisionDetector::checkCollision(const RigidBody& a, const RigidBody& b) {
 
 RigidContact* CollisionDetector::generateRigidContact(RigidBody& a, RigidBody& b) {
     if (a.shapeType == ShapeType::CIRCLE && b.shapeType == ShapeType::CIRCLE) {
-        Vector2 delta = b.position - a.position;
-        float distance = delta.magnitude();
-        float radiusSum = a.radius + b.radius;
-        
-        if (distance >= radiusSum) return nullptr;
-        
-        Vector2 normal;
-        if (distance > 0.001f) {
-            normal = delta / distance;
-        } else {
-            normal = Vector2(0, -1);
+        Vector2 contactPoint, normal;
+        float penetration;
+        if (!circleCircleContact(a.position, a.radius, b.position, b.radius, contactPoint, normal, penetration)) {
+            return nullptr;
         }
-        
-        float penetration = radiusSum - distance;
-        Vector2 contactPoint = a.position + normal * a.radius;
-        
         return new RigidContact(&a, &b, contactPoint, normal, penetration);
     }
     
-    if ((a.shapeType == ShapeType::CIRCLE && b.shapeType == ShapeType::BOX) ||
-        (a.shapeType == ShapeType::BOX && b.shapeType == ShapeType::CIRCLE)) {
-        return nullptr; 
+    if (a.shapeType == ShapeType::CIRCLE && b.shapeType == ShapeType::BOX) {
+        return generateCircleBoxContact(a, b);
+    }
+    
+    if (a.shapeType == ShapeType::BOX && b.shapeType == ShapeType::CIRCLE) {
+        return generateCircleBoxContact(b, a);
     }
     
     if (a.shapeType == ShapeType::BOX && b.shapeType == ShapeType::BOX) {
@@ -221,8 +278,63 @@ bool CollisionDetector::checkCircleBoxCollision(const RigidBody& circle, const R
 }
 
 RigidContact* CollisionDetector::generateCircleBoxContact(RigidBody& circle, RigidBody& box) {
-    auto vertices = box.getVertices();
-    if (vertices.empty()) return nullptr;
+    if (box.shapeType != ShapeType::BOX) return nullptr;
+    
+    Vector2 contactPoint, normal;
+    float penetration;
+    if (!circleBoxContact(circle.position, circle.radius, box.position, box.orientation, box.width, box.height,
+                          contactPoint, normal, penetration)) {
+        return nullptr;
+    }
+    return new RigidContact(&circle, &box, contactPoint, normal, penetration);
+}
+
+static void boxVertices(const Vector2& position, float orientation, float width, float height, Vector2* vertices) {
+    float hw = width * 0.5f;
+    float hh = height * 0.5f;
+    
+    vertices[0] = Vector2(-hw, -hh);
+    vertices[1] = Vector2(hw, -hh);
+    vertices[2] = Vector2(hw, hh);
+    vertices[3] = Vector2(-hw, hh);
+    
+    float cos_a = std::cos(orientation);
+    float sin_a = std::sin(orientation);
+    
+    for (int i = 0; i < 4; i++) {
+        Vector2& v = vertices[i];
+        float x = v.x * cos_a - v.y * sin_a;
+        float y = v.x * sin_a + v.y * cos_a;
+        v.x = x + position.x;
+        v.y = y + position.y;
+    }
+}
+
+bool CollisionDetector::circleCircleContact(const Vector2& positionA, float radiusA, const Vector2& positionB,
+                                            float radiusB, Vector2& contactPoint, Vector2& normal,
+                                            float& penetration) {
+    Vector2 delta = positionB - positionA;
+    float distance = delta.magnitude();
+    float radiusSum = radiusA + radiusB;
+    
+    if (distance >= radiusSum) return false;
+    
+    if (distance > 0.001f) {
+        normal = delta / distance;
+    } else {
+        normal = Vector2(0, -1);
+    }
+    
+    penetration = radiusSum - distance;
+    contactPoint = positionA + normal * radiusA;
+    return true;
+}
+
+bool CollisionDetector::circleBoxContact(const Vector2& circlePosition, float radius, const Vector2& boxPosition,
+                                         float orientation, float width, float height,
+                                         Vector2& contactPoint, Vector2& normal, float& penetration) {
+    Vector2 vertices[4];
+    boxVertices(boxPosition, orientation, width, height, vertices);
     
     float minDistance = std::numeric_limits<float>::max();
     Vector2 closestPoint;
@@ -238,20 +350,20 @@ RigidContact* CollisionDetector::generateCircleBoxContact(RigidBody& circle, Rig
         
         if (edgeLength < 0.001f) continue;
         
-        Vector2 toCircle = circle.position - p1;
+        Vector2 toCircle = circlePosition - p1;
         
         float t = toCircle.dot(edge) / (edgeLength * edgeLength);
         t = std::max(0.0f, std::min(1.0f, t));
         
         Vector2 pointOnEdge = p1 + edge * t;
         
-        float distance = Vector2::distance(circle.position, pointOnEdge);
+        float distance = Vector2::distance(circlePosition, pointOnEdge);
         
         if (distance < minDistance) {
             minDistance = distance;
             closestPoint = pointOnEdge;
             
-            Vector2 diff = circle.position - pointOnEdge;
+            Vector2 diff = pointOnEdge - circlePosition;
             if (diff.magnitude() > 0.001f) {
                 bestNormal = diff.normalize();
             } else {
@@ -263,14 +375,21 @@ RigidContact* CollisionDetector::generateCircleBoxContact(RigidBody& circle, Rig
         }
     }
     
-    if (!found) return nullptr;
+    if (!found) return false;
     
-    if (minDistance >= circle.radius) return nullptr;
+    Vector2 local = Vector2::rotate(circlePosition - boxPosition, -orientation);
+    bool inside = std::abs(local.x) < width * 0.5f && std::abs(local.y) < height * 0.5f;
     
-    float penetration = circle.radius - minDistance;
-    Vector2 contactPoint = closestPoint;
+    if (!inside && minDistance >= radius) return false;
     
-    return new RigidContact(&circle, &box, contactPoint, bestNormal, penetration);
+    penetration = radius - minDistance;
+    if (inside) {
+        bestNormal = bestNormal * -1.0f;
+        penetration = radius + minDistance;
+    }
+    normal = bestNormal;
+    contactPoint = closestPoint;
+    return true;
 }
 
 bool CollisionDetector::checkBoxBoxCollision(const RigidBody& a, const RigidBody& b) {
@@ -282,20 +401,26 @@ bool CollisionDetector::checkBoxBoxCollision(const RigidBody& a, const RigidBody
 }
 
 RigidContact* CollisionDetector::generateBoxBoxContact(RigidBody& a, RigidBody& b) {
-    Vector2 delta = b.position - a.position;
+    Vector2 contactPoint, normal;
+    float penetration;
+    if (!boxBoxContact(a.position, std::max(a.width, a.height) * 0.5f, b.position, std::max(b.width, b.height) * 0.5f,
+                       contactPoint, normal, penetration)) {
+        return nullptr;
+    }
+    return new RigidContact(&a, &b, contactPoint, normal, penetration);
+}
+
+bool CollisionDetector::boxBoxContact(const Vector2& positionA, float radiusA, const Vector2& positionB,
+                                      float radiusB, Vector2& contactPoint, Vector2& normal, float& penetration) {
+    Vector2 delta = positionB - positionA;
     float distance = delta.magnitude();
     
-    if (distance < 0.001f) return nullptr;
-    
-    Vector2 normal = delta / distance;
+    if (distance < 0.001f) return false;
     
-    float radiusA = std::max(a.width, a.height) * 0.5f;
-    float radiusB = std::max(b.width, b.height) * 0.5f;
-    float penetration = (radiusA + radiusB) - distance;
+    penetration = (radiusA + radiusB) - distance;
+    if (penetration <= 0) return false;
     
-    if (penetration <= 0) return nullptr;
-    
-    Vector2 contactPoint = a.position + normal * radiusA;
-    
-    return new RigidContact(&a, &b, contactPoint, normal, penetration);
+    normal = delta / distance;
+    contactPoint = positionA + normal * radiusA;
+    return true;
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "Particle.h"
 #include "Vector2.h"
 #include <vector>
+#include <cstdint>
 #include "RigidBody.h"
 
 struct Contact {
@@ -37,6 +38,12 @@ struct RigidContact {
                     const Vector2& n, float pen)
             : bodyA(a), bodyB(b), contactPoint(point), normal(n), penetration(pen) {}
     };
+
+struct BodyPair {
+    uint32_t a;
+    uint32_t b;
+};
+
 class CollisionDetector {
 public:
     static bool checkCollision(const Particle& a, const Particle& b);
@@ -53,6 +60,14 @@ public:
     
     static bool checkBoxBoxCollision(const RigidBody& a, const RigidBody& b);
     static RigidContact* generateBoxBoxContact(RigidBody& a, RigidBody& b); 
+    
+    static bool circleCircleContact(const Vector2& positionA, float radiusA, const Vector2& positionB,
+                                    float radiusB, Vector2& contactPoint, Vector2& normal, float& penetration);
+    static bool circleBoxContact(const Vector2& circlePosition, float radius, const Vector2& boxPosition,
+                                 float orientation, float width, float height,
+                                 Vector2& contactPoint, Vector2& normal, float& penetration);
+    static bool boxBoxContact(const Vector2& positionA, float radiusA, const Vector2& positionB,
+                              float radiusB, Vector2& contactPoint, Vector2& normal, float& penetration);
 };
 
 class SpatialGrid {
@@ -62,12 +77,36 @@ private:
     int gridHeight;
     std::vector<std::vector<std::vector<Particle*>>> grid;
     
+    const Particle* trackedBase;
+    size_t trackedCount;
+    std::vector<int32_t> particleCell;
+    std::vector<uint32_t> particleSlot;
+    std::vector<uint8_t> cellDirty;
+    std::vector<uint32_t> dirtyCells;
+    size_t movedCount;
+    
+    void markDirty(int32_t cell);
+    void track(Particle* particle, size_t index, int32_t cell);
+    
 public:
     SpatialGrid(int screenWidth, int screenHeight, int cellSize);
     
     void clear();
     void insert(Particle& particle);
     std::vector<Particle*> query(const Particle& particle);
+    void query(const Particle& particle, std::vector<Particle*>& out) const;
+    
+    void update(std::vector<Particle>& particles);
+    void invalidate() { trackedCount = 0; }
+    void clearDirty();
+    const std::vector<uint32_t>& getDirtyCells() const { return dirtyCells; }
+    size_t getMovedCount() const { return movedCount; }
+    int32_t getParticleCell(size_t particle) const { return particleCell[particle]; }
+    
+    int getWidth() const { return gridWidth; }
+    int getHeight() const { return gridHeight; }
+    size_t getCellCount() const { return static_cast<size_t>(gridWidth) * gridHeight; }
+    const std::vector<Particle*>& getCell(uint32_t cell) const { return grid[cell / gridHeight][cell % gridHeight]; }
     
 private:
     int getGridX(float x) const;
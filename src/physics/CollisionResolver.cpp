@@ -3,7 +3,7 @@
 #include <cmath>
 
 CollisionResolver::CollisionResolver(float restitution)
-    : restitution(restitution) {}
+    : restitution(restitution), solverMode(ContactSolverMode::GAUSS_SEIDEL) {}
 
 float CollisionResolver::calculateSeparatingVelocity(const Contact& contact) {
     Vector2 relativeVelocity = contact.particleB->velocity - contact.particleA->velocity;
@@ -22,13 +22,9 @@ void CollisionResolver::resolveVelocity(Contact& contact) {
     
     float deltaVelocity = newSeparatingVelocity - separatingVelocity;
     
-    float totalInverseMass = 0.0f;
-    if (!contact.particleA->hasInfiniteMass()) {
-        totalInverseMass += 1.0f / contact.particleA->mass;
-    }
-    if (!contact.particleB->hasInfiniteMass()) {
-        totalInverseMass += 1.0f / contact.particleB->mass;
-    }
+    float inverseMassA = contact.particleA->getInverseMass();
+    float inverseMassB = contact.particleB->getInverseMass();
+    float totalInverseMass = inverseMassA + inverseMassB;
     
     if (totalInverseMass <= 0) return;
     
@@ -36,37 +32,23 @@ void CollisionResolver::resolveVelocity(Contact& contact) {
     
     Vector2 impulsePerMass = contact.normal * impulse;
     
-    if (!contact.particleA->hasInfiniteMass()) {
-        contact.particleA->velocity += impulsePerMass * (-1.0f / contact.particleA->mass);
-    }
-    if (!contact.particleB->hasInfiniteMass()) {
-        contact.particleB->velocity += impulsePerMass * (1.0f / contact.particleB->mass);
-    }
+    contact.particleA->velocity -= impulsePerMass * inverseMassA;
+    contact.particleB->velocity += impulsePerMass * inverseMassB;
 }
 
 void CollisionResolver::resolveInterpenetration(Contact& contact) {
     if (contact.penetration <= 0) return;
     
-    float totalInverseMass = 0.0f;
-    if (!contact.particleA->hasInfiniteMass()) {
-        totalInverseMass += 1.0f / contact.particleA->mass;
-    }
-    if (!contact.particleB->hasInfiniteMass()) {
-        totalInverseMass += 1.0f / contact.particleB->mass;
-    }
+    float inverseMassA = contact.particleA->getInverseMass();
+    float inverseMassB = contact.particleB->getInverseMass();
+    float totalInverseMass = inverseMassA + inverseMassB;
     
     if (totalInverseMass <= 0) return;
     
     Vector2 movePerInverseMass = contact.normal * (contact.penetration / totalInverseMass);
     
-    if (!contact.particleA->hasInfiniteMass()) {
-        float inverseMassA = 1.0f / contact.particleA->mass;
-        contact.particleA->position -= movePerInverseMass * inverseMassA;
-    }
-    if (!contact.particleB->hasInfiniteMass()) {
-        float inverseMassB = 1.0f / contact.particleB->mass;
-        contact.particleB->position += movePerInverseMass * inverseMassB;
-    }
+    contact.particleA->position -= movePerInverseMass * inverseMassA;
+    contact.particleB->position += movePerInverseMass * inverseMassB;
 }
 
 void CollisionResolver::resolveContact(Contact& contact) {
@@ -79,4 +61,14 @@ void CollisionResolver::resolveContacts(std::vector<Contact>& contacts) {
     for (auto& contact : contacts) {
         resolveContact(contact);
     }
+}
+
+void CollisionResolver::resolveContacts(std::vector<Contact>& contacts, std::vector<Particle>& particles,
+                                        ThreadPool& pool) {
+    if (solverMode == ContactSolverMode::JACOBI) {
+        jacobiSolver.solve(contacts, particles, restitution, pool);
+        return;
+    }
+    
+    resolveContacts(contacts);
 }
\ No newline at end of file
@@ -1,22 +1,36 @@
 #pragma once
 #include "Particle.h"
 #include "Collision.h"
+#include "JacobiContactSolver.h"
+#include "ThreadPool.h"
 #include <vector>
 
+enum class ContactSolverMode {
+    GAUSS_SEIDEL,
+    JACOBI
+};
+
 class CollisionResolver {
 private:
     float restitution; 
+    ContactSolverMode solverMode;
+    JacobiContactSolver jacobiSolver;
     
 public:
     CollisionResolver(float restitution = 0.7f);
     
     void setRestitution(float e) { restitution = e; }
     float getRestitution() const { return restitution; }
+    void setSolverMode(ContactSolverMode mode) { solverMode = mode; }
+    ContactSolverMode getSolverMode() const { return solverMode; }
+    JacobiContactSolver& getJacobiSolver() { return jacobiSolver; }
     
     void resolveContact(Contact& contact);
     
     void resolveContacts(std::vector<Contact>& contacts);
     
+    void resolveContacts(std::vector<Contact>& contacts, std::vector<Particle>& particles, ThreadPool& pool);
+    
     void resolveVelocity(Contact& contact);
     
     void resolveInterpenetration(Contact& contact);
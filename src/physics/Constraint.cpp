@@ -2,10 +2,32 @@
 #include "Renderer.h"
 #include <cmath>
 
+static float solveDistanceXPBD(Particle& a, Particle& b, float restLength, float alpha, float lambda,
+                               float gamma, const Vector2& previousA, const Vector2& previousB) {
+    float wA = a.getInverseMass();
+    float wB = b.getInverseMass();
+    float w = wA + wB;
+    if (w + alpha <= 0.0f) return 0.0f;
+    
+    Vector2 delta = b.position - a.position;
+    float length = delta.magnitude();
+    if (length == 0) return 0.0f;
+    
+    Vector2 n = delta / length;
+    float c = length - restLength;
+    float rate = gamma > 0.0f ? n.dot((b.position - previousB) - (a.position - previousA)) : 0.0f;
+    float deltaLambda = (-c - alpha * lambda - gamma * rate) / ((1.0f + gamma) * w + alpha);
+    
+    a.position -= n * (wA * deltaLambda);
+    b.position += n * (wB * deltaLambda);
+    
+    return deltaLambda;
+}
+
 SpringConstraint::SpringConstraint(Particle* a, Particle* b, float restLength,
                                    float stiffness, float damping)
     : particleA(a), particleB(b), restLength(restLength), 
-      stiffness(stiffness), damping(damping) {}
+      stiffness(stiffness), damping(damping), lambda(0.0f), startA(0, 0), startB(0, 0) {}
 
 void SpringConstraint::solve() {
     Vector2 delta = particleB->position - particleA->position;
@@ -29,6 +51,21 @@ void SpringConstraint::solve() {
     }
 }
 
+void SpringConstraint::solvePositions(float dt) {
+    if (stiffness <= 0.0f) return;
+    
+    float alpha = 1.0f / (stiffness * dt * dt);
+    float gamma = damping / (stiffness * dt);
+    Vector2 previousA = particleA->hasInfiniteMass() ? startA : startA - particleA->velocity * dt;
+    Vector2 previousB = particleB->hasInfiniteMass() ? startB : startB - particleB->velocity * dt;
+    lambda += solveDistanceXPBD(*particleA, *particleB, restLength, alpha, lambda, gamma, previousA, previousB);
+}
+
+void SpringConstraint::remapParticles(const ParticleRemap& remap) {
+    particleA = remap(particleA);
+    particleB = remap(particleB);
+}
+
 void SpringConstraint::render(Renderer& renderer) {
     renderer.drawLine(particleA->position, particleB->position, 
                      sf::Color(100, 200, 255));
@@ -36,7 +73,8 @@ void SpringConstraint::render(Renderer& renderer) {
 
 DistanceConstraint::DistanceConstraint(Particle* a, Particle* b, 
                                        float distance, float stiffness)
-    : particleA(a), particleB(b), distance(distance), stiffness(stiffness) {}
+    : particleA(a), particleB(b), distance(distance), stiffness(stiffness),
+      compliance(0.0f), lambda(0.0f) {}
 
 void DistanceConstraint::solve() {
     Vector2 delta = particleB->position - particleA->position;
@@ -55,13 +93,25 @@ void DistanceConstraint::solve() {
     }
 }
 
+void DistanceConstraint::solvePositions(float dt) {
+    float alpha = compliance / (dt * dt);
+    lambda += solveDistanceXPBD(*particleA, *particleB, distance, alpha, lambda, 0.0f,
+                                particleA->position, particleB->position);
+}
+
+void DistanceConstraint::remapParticles(const ParticleRemap& remap) {
+    particleA = remap(particleA);
+    particleB = remap(particleB);
+}
+
 void DistanceConstraint::render(Renderer& renderer) {
     renderer.drawLine(particleA->position, particleB->position, 
                      sf::Color(255, 200, 100));
 }
 
 PinConstraint::PinConstraint(Particle* p, const Vector2& pos, float stiffness)
-    : particle(p), position(pos), stiffness(stiffness) {}
+    : particle(p), position(pos), stiffness(stiffness),
+      compliance(0.0f), lambda(0.0f) {}
 
 void PinConstraint::solve() {
     if (particle->hasInfiniteMass()) return;
@@ -70,6 +120,24 @@ void PinConstraint::solve() {
     particle->position += delta * stiffness;
 }
 
+void PinConstraint::solvePositions(float dt) {
+    float w = particle->getInverseMass();
+    if (w <= 0.0f) return;
+    
+    Vector2 delta = particle->position - position;
+    float length = delta.magnitude();
+    if (length == 0) return;
+    
+    float alpha = compliance / (dt * dt);
+    float deltaLambda = (-length - alpha * lambda) / (w + alpha);
+    lambda += deltaLambda;
+    particle->position += delta * (w * deltaLambda / length);
+}
+
+void PinConstraint::remapParticles(const ParticleRemap& remap) {
+    particle = remap(particle);
+}
+
 void PinConstraint::render(Renderer& renderer) {
     renderer.drawCircle(position, 5, sf::Color::Red);
     renderer.drawLine(position, particle->position, sf::Color(255, 100, 100));
@@ -99,6 +167,12 @@ void AngleConstraint::solve() {
     
 }
 
+void AngleConstraint::remapParticles(const ParticleRemap& remap) {
+    particleA = remap(particleA);
+    particleB = remap(particleB);
+    particleC = remap(particleC);
+}
+
 void AngleConstraint::render(Renderer& renderer) {
     renderer.drawLine(particleA->position, particleB->position, 
                      sf::Color(150, 150, 255));
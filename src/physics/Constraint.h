@@ -6,61 +6,91 @@ class Constraint {
 public:
     virtual ~Constraint() = default;
     virtual void solve() = 0;  
+    virtual void solvePositions(float dt) { (void)dt; solve(); }
+    virtual void resetLambda() {}
+    virtual void remapParticles(const ParticleRemap& remap) = 0;
     virtual void render(class Renderer& renderer) = 0;  
 };
 
-class SpringConstraint : public Constraint {
+class SpringConstraint final : public Constraint {
 private:
     Particle* particleA;
     Particle* particleB;
     float restLength;    
     float stiffness;     
     float damping;       
+    float lambda;
+    Vector2 startA;
+    Vector2 startB;
     
 public:
     SpringConstraint(Particle* a, Particle* b, float restLength, 
                      float stiffness, float damping = 0.1f);
     
     void solve() override;
+    void solvePositions(float dt) override;
+    void resetLambda() override {
+        lambda = 0.0f;
+        startA = particleA->position;
+        startB = particleB->position;
+    }
+    void remapParticles(const ParticleRemap& remap) override;
     void render(Renderer& renderer) override;
     
     void setStiffness(float k) { stiffness = k; }
     void setDamping(float d) { damping = d; }
+    float getStiffness() const { return stiffness; }
+    float getDamping() const { return damping; }
+    float getRestLength() const { return restLength; }
+    Particle* getParticleA() const { return particleA; }
+    Particle* getParticleB() const { return particleB; }
 };
 
-class DistanceConstraint : public Constraint {
+class DistanceConstraint final : public Constraint {
 private:
     Particle* particleA;
     Particle* particleB;
     float distance;      
     float stiffness;     
+    float compliance;
+    float lambda;
     
 public:
     DistanceConstraint(Particle* a, Particle* b, float distance, 
                        float stiffness = 1.0f);
     
     void solve() override;
+    void solvePositions(float dt) override;
+    void resetLambda() override { lambda = 0.0f; }
+    void remapParticles(const ParticleRemap& remap) override;
     void render(Renderer& renderer) override;
     
     void setStiffness(float s) { stiffness = s; }
+    void setCompliance(float c) { compliance = c; }
 };
 
-class PinConstraint : public Constraint {
+class PinConstraint final : public Constraint {
 private:
     Particle* particle;
     Vector2 position;
     float stiffness;
+    float compliance;
+    float lambda;
     
 public:
     PinConstraint(Particle* p, const Vector2& pos, float stiffness = 1.0f);
     
     void solve() override;
+    void solvePositions(float dt) override;
+    void resetLambda() override { lambda = 0.0f; }
+    void remapParticles(const ParticleRemap& remap) override;
     void render(Renderer& renderer) override;
     
     void setPosition(const Vector2& pos) { position = pos; }
+    void setCompliance(float c) { compliance = c; }
 };
 
-class AngleConstraint : public Constraint {
+class AngleConstraint final : public Constraint {
 private:
     Particle* particleA;
     Particle* particleB;
@@ -73,5 +103,6 @@ public:
                     float angle, float stiffness = 0.5f);
     
     void solve() override;
+    void remapParticles(const ParticleRemap& remap) override;
     void render(Renderer& renderer) override;
 };
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "ConstraintStore.h"
+
+size_t ConstraintStore::add(const DistanceConstraint& constraint) {
+    distanceConstraints.push_back(constraint);
+    return distanceConstraints.size() - 1;
+}
+
+size_t ConstraintStore::add(const SpringConstraint& constraint) {
+    springConstraints.push_back(constraint);
+    return springConstraints.size() - 1;
+}
+
+size_t ConstraintStore::add(const PinConstraint& constraint) {
+    pinConstraints.push_back(constraint);
+    return pinConstraints.size() - 1;
+}
+
+size_t ConstraintStore::add(const AngleConstraint& constraint) {
+    angleConstraints.push_back(constraint);
+    return angleConstraints.size() - 1;
+}
+
+void ConstraintStore::solve() {
+    for (auto& c : springConstraints) c.solve();
+    for (auto& c : distanceConstraints) c.solve();
+    for (auto& c : pinConstraints) c.solve();
+    for (auto& c : angleConstraints) c.solve();
+}
+
+void ConstraintStore::solvePositions(float dt) {
+    for (auto& c : springConstraints) c.solvePositions(dt);
+    for (auto& c : distanceConstraints) c.solvePositions(dt);
+    for (auto& c : pinConstraints) c.solvePositions(dt);
+    for (auto& c : angleConstraints) c.solvePositions(dt);
+}
+
+void ConstraintStore::resetLambda() {
+    for (auto& c : springConstraints) c.resetLambda();
+    for (auto& c : distanceConstraints) c.resetLambda();
+    for (auto& c : pinConstraints) c.resetLambda();
+}
+
+void ConstraintStore::remapParticles(const ParticleRemap& remap) {
+    forEach([&](Constraint& c) { c.remapParticles(remap); });
+}
+
+void ConstraintStore::render(Renderer& renderer) {
+    forEach([&](Constraint& c) { c.render(renderer); });
+}
+
+size_t ConstraintStore::size() const {
+    return distanceConstraints.size() + springConstraints.size() +
+           pinConstraints.size() + angleConstraints.size();
+}
+
+void ConstraintStore::clear() {
+    distanceConstraints.clear();
+    springConstraints.clear();
+    pinConstraints.clear();
+    angleConstraints.clear();
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+#include "Constraint.h"
+#include <vector>
+
+class ConstraintStore {
+private:
+    std::vector<DistanceConstraint> distanceConstraints;
+    std::vector<SpringConstraint> springConstraints;
+    std::vector<PinConstraint> pinConstraints;
+    std::vector<AngleConstraint> angleConstraints;
+    
+public:
+    size_t add(const DistanceConstraint& constraint);
+    size_t add(const SpringConstraint& constraint);
+    size_t add(const PinConstraint& constraint);
+    size_t add(const AngleConstraint& constraint);
+    
+    void solve();
+    void solvePositions(float dt);
+    void resetLambda();
+    void remapParticles(const ParticleRemap& remap);
+    void render(class Renderer& renderer);
+    
+    template <typename Fn>
+    void forEach(Fn&& fn) {
+        for (auto& c : distanceConstraints) fn(c);
+        for (auto& c : springConstraints) fn(c);
+        for (auto& c : pinConstraints) fn(c);
+        for (auto& c : angleConstraints) fn(c);
+    }
+    
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+    void clear();
+    
+    std::vector<DistanceConstraint>& getDistanceConstraints() { return distanceConstraints; }
+    std::vector<SpringConstraint>& getSpringConstraints() { return springConstraints; }
+    std::vector<PinConstraint>& getPinConstraints() { return pinConstraints; }
+    std::vector<AngleConstraint>& getAngleConstraints() { return angleConstraints; }
+};
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "ContactEvents.h"
+#include <algorithm>
+
+uint64_t ContactEvents::makeKey(uint32_t a, uint32_t b) {
+    if (a > b) std::swap(a, b);
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+void ContactEvents::record(uint32_t a, uint32_t b, const Vector2& contactPoint,
+                           const Vector2& normal, float penetration) {
+    current.push_back({ makeKey(a, b), contactPoint, normal, penetration });
+}
+
+void ContactEvents::emit(const ContactRecord& record, ContactPhase phase, const uint8_t* flags) {
+    uint32_t a = static_cast<uint32_t>(record.key >> 32);
+    uint32_t b = static_cast<uint32_t>(record.key);
+    uint8_t mask = static_cast<uint8_t>(1u << static_cast<int>(phase));
+    if (flags && ((flags[a] | flags[b]) & mask) == 0) return;
+    events.push_back({ a, b, phase, record.contactPoint, record.normal, record.penetration });
+}
+
+void ContactEvents::endStep(const uint8_t* flags, const ContactPairFilter& unobserved) {
+    events.clear();
+    merged.clear();
+    
+    std::sort(current.begin(), current.end(), [](const ContactRecord& x, const ContactRecord& y) {
+        return x.key < y.key || (x.key == y.key && x.penetration > y.penetration);
+    });
+    current.erase(std::unique(current.begin(), current.end(), [](const ContactRecord& x, const ContactRecord& y) {
+        return x.key == y.key;
+    }), current.end());
+    
+    size_t i = 0;
+    size_t j = 0;
+    while (i < current.size() || j < previous.size()) {
+        if (j == previous.size() || (i < current.size() && current[i].key < previous[j].key)) {
+            emit(current[i], ContactPhase::BEGIN, flags);
+            merged.push_back(current[i++]);
+        } else if (i == current.size() || previous[j].key < current[i].key) {
+            const ContactRecord& record = previous[j++];
+            uint32_t a = static_cast<uint32_t>(record.key >> 32);
+            uint32_t b = static_cast<uint32_t>(record.key);
+            if (unobserved && unobserved(a, b)) {
+                emit(record, ContactPhase::PERSIST, flags);
+                merged.push_back(record);
+            } else {
+                emit(record, ContactPhase::END, flags);
+            }
+        } else {
+            emit(current[i], ContactPhase::PERSIST, flags);
+            merged.push_back(current[i++]);
+            j++;
+        }
+    }
+    
+    std::swap(merged, previous);
+    current.clear();
+}
+
+void ContactEvents::remap(const std::vector<uint32_t>& newIndex, const uint8_t* flags) {
+    auto lookup = [&newIndex](uint32_t index) {
+        return index < newIndex.size() ? newIndex[index] : UINT32_MAX;
+    };
+    
+    size_t write = 0;
+    for (const ContactEvent& event : events) {
+        ContactEvent moved = event;
+        moved.a = lookup(event.a);
+        moved.b = lookup(event.b);
+        bool removed = moved.a == UINT32_MAX || moved.b == UINT32_MAX;
+        if (removed && event.phase != ContactPhase::END) continue;
+        events[write++] = moved;
+    }
+    events.resize(write);
+    
+    write = 0;
+    for (const ContactRecord& record : previous) {
+        uint32_t a = static_cast<uint32_t>(record.key >> 32);
+        uint32_t b = static_cast<uint32_t>(record.key);
+        uint32_t newA = lookup(a);
+        uint32_t newB = lookup(b);
+        
+        if (newA == UINT32_MAX || newB == UINT32_MAX) {
+            if (!flags || ((flags[a] | flags[b]) & CONTACT_EVENTS_END)) {
+                events.push_back({ newA, newB, ContactPhase::END, record.contactPoint, record.normal,
+                                   record.penetration });
+            }
+            continue;
+        }
+        
+        ContactRecord moved = record;
+        moved.key = makeKey(newA, newB);
+        previous[write++] = moved;
+    }
+    previous.resize(write);
+    std::sort(previous.begin(), previous.end(), [](const ContactRecord& x, const ContactRecord& y) {
+        return x.key < y.key;
+    });
+    current.clear();
+}
+
+void ContactEvents::clear() {
+    current.clear();
+    previous.clear();
+    events.clear();
+}
+
+void ContactEvents::dispatch() const {
+    if (!listener) return;
+    for (const ContactEvent& event : events) {
+        listener(event);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "Vector2.h"
+
+enum class ContactPhase : uint8_t {
+    BEGIN,
+    PERSIST,
+    END
+};
+
+enum ContactEventFlags : uint8_t {
+    CONTACT_EVENTS_NONE = 0,
+    CONTACT_EVENTS_BEGIN = 1u << 0,
+    CONTACT_EVENTS_PERSIST = 1u << 1,
+    CONTACT_EVENTS_END = 1u << 2,
+    CONTACT_EVENTS_ALL = CONTACT_EVENTS_BEGIN | CONTACT_EVENTS_PERSIST | CONTACT_EVENTS_END
+};
+
+using ContactPairFilter = std::function<bool(uint32_t, uint32_t)>;
+
+struct ContactEvent {
+    uint32_t a;
+    uint32_t b;
+    ContactPhase phase;
+    Vector2 contactPoint;
+    Vector2 normal;
+    float penetration;
+};
+
+class ContactEvents {
+private:
+    struct ContactRecord {
+        uint64_t key;
+        Vector2 contactPoint;
+        Vector2 normal;
+        float penetration;
+    };
+    
+    std::vector<ContactRecord> current;
+    std::vector<ContactRecord> previous;
+    std::vector<ContactRecord> merged;
+    std::vector<ContactEvent> events;
+    std::function<void(const ContactEvent&)> listener;
+    
+    static uint64_t makeKey(uint32_t a, uint32_t b);
+    void emit(const ContactRecord& record, ContactPhase phase, const uint8_t* flags);
+    
+public:
+    void record(uint32_t a, uint32_t b, const Vector2& contactPoint, const Vector2& normal, float penetration);
+    void endStep(const uint8_t* flags, const ContactPairFilter& unobserved = nullptr);
+    void remap(const std::vector<uint32_t>& newIndex, const uint8_t* flags);
+    void clear();
+    
+    void setListener(std::function<void(const ContactEvent&)> callback) { listener = std::move(callback); }
+    void dispatch() const;
+    
+    const std::vector<ContactEvent>& getEvents() const { return events; }
+    size_t getActivePairCount() const { return previous.size(); }
+};
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "ContactIslands.h"
+#include <algorithm>
+
+uint32_t ContactIslands::find(uint32_t body) {
+    while (parent[body] != body) {
+        parent[body] = parent[parent[body]];
+        body = parent[body];
+    }
+    return body;
+}
+
+void ContactIslands::unite(uint32_t a, uint32_t b) {
+    uint32_t rootA = find(a);
+    uint32_t rootB = find(b);
+    if (rootA == rootB) return;
+    
+    if (rootA < rootB) {
+        parent[rootB] = rootA;
+    } else {
+        parent[rootA] = rootB;
+    }
+}
+
+void ContactIslands::build(size_t bodyCount, const std::vector<BodyPair>& contactBodies,
+                           const std::vector<uint8_t>& isStatic) {
+    parent.resize(bodyCount);
+    for (size_t i = 0; i < bodyCount; i++) {
+        parent[i] = static_cast<uint32_t>(i);
+    }
+    
+    for (const auto& pair : contactBodies) {
+        if (isStatic[pair.a] || isStatic[pair.b]) continue;
+        unite(pair.a, pair.b);
+    }
+    
+    const uint32_t none = UINT32_MAX;
+    islandOfRoot.assign(bodyCount, none);
+    contactIsland.resize(contactBodies.size());
+    
+    uint32_t islandCount = 0;
+    for (size_t i = 0; i < contactBodies.size(); i++) {
+        const BodyPair& pair = contactBodies[i];
+        uint32_t body = isStatic[pair.a] ? pair.b : pair.a;
+        uint32_t root = find(body);
+        
+        if (islandOfRoot[root] == none) {
+            islandOfRoot[root] = islandCount++;
+        }
+        contactIsland[i] = islandOfRoot[root];
+    }
+    
+    islandStart.assign(islandCount + 1, 0);
+    for (uint32_t island : contactIsland) {
+        islandStart[island + 1]++;
+    }
+    for (uint32_t i = 0; i < islandCount; i++) {
+        islandStart[i + 1] += islandStart[i];
+    }
+    
+    islandContacts.resize(contactBodies.size());
+    cursor.assign(islandStart.begin(), islandStart.end() - 1);
+    for (size_t i = 0; i < contactBodies.size(); i++) {
+        islandContacts[cursor[contactIsland[i]]++] = static_cast<uint32_t>(i);
+    }
+    
+    islandOrder.resize(islandCount);
+    for (uint32_t i = 0; i < islandCount; i++) {
+        islandOrder[i] = i;
+    }
+    std::sort(islandOrder.begin(), islandOrder.end(), [this](uint32_t a, uint32_t b) {
+        return getIslandSize(a) > getIslandSize(b);
+    });
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+#include "Collision.h"
+#include <cstdint>
+#include <vector>
+
+class ContactIslands {
+private:
+    std::vector<uint32_t> parent;
+    std::vector<uint32_t> islandOfRoot;
+    std::vector<uint32_t> contactIsland;
+    std::vector<uint32_t> islandStart;
+    std::vector<uint32_t> islandContacts;
+    std::vector<uint32_t> islandOrder;
+    std::vector<uint32_t> cursor;
+    
+    uint32_t find(uint32_t body);
+    void unite(uint32_t a, uint32_t b);
+    
+public:
+    void build(size_t bodyCount, const std::vector<BodyPair>& contactBodies,
+               const std::vector<uint8_t>& isStatic);
+    
+    size_t getIslandCount() const { return islandOrder.size(); }
+    
+    size_t getIslandSize(size_t island) const {
+        return islandStart[island + 1] - islandStart[island];
+    }
+    
+    const uint32_t* getIslandContacts(size_t island) const {
+        return islandContacts.data() + islandStart[island];
+    }
+    
+    const std::vector<uint32_t>& getIslandsBySize() const { return islandOrder; }
+};
\ No newline at end of file
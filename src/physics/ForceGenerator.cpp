@@ -5,7 +5,7 @@ GravityForce::GravityForce(const Vector2& g) : gravity(g) {}
 
 void GravityForce::applyForce(Particle& particle, float dt) {
     if (!particle.hasInfiniteMass()) {
-        particle.addForce(gravity * particle.mass);
+        particle.addForce(gravity * particle.getMass());
     }
 }
 
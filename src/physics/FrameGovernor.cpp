@@ -0,0 +1,84 @@
+#include "FrameGovernor.h"
+#include <algorithm>
+#include <cmath>
+
+FrameGovernor::FrameGovernor(double budgetMs, size_t historySize, size_t adjustmentLimit)
+    : history(historySize > 0 ? historySize : 1, 0.0),
+      adjustmentLimit(adjustmentLimit > 0 ? adjustmentLimit : 1), adjustmentCursor(0),
+      historyCursor(0), historyCount(0),
+      budgetMs(budgetMs), averageMs(0.0), smoothing(0.2), recoverRatio(0.6), recoverFrames(30),
+      cooldownFrames(5), calmFrames(0), cooldown(0), frame(0), stepStart(Clock::now()) {}
+
+size_t FrameGovernor::addKnob(const std::string& name, float value, float minValue, float maxValue, float step,
+                              std::function<void(float)> apply) {
+    knobs.push_back({ name, value, minValue, maxValue, step, std::move(apply) });
+    return knobs.size() - 1;
+}
+
+void FrameGovernor::endStep() {
+    record(std::chrono::duration<double, std::milli>(Clock::now() - stepStart).count());
+}
+
+void FrameGovernor::adjust(GovernorKnob& knob, float value, double stepMs) {
+    GovernorAdjustment adjustment = { frame, knob.name, knob.value, value, stepMs, averageMs };
+    knob.value = value;
+    knob.apply(value);
+    if (adjustments.size() < adjustmentLimit) {
+        adjustments.push_back(adjustment);
+    } else {
+        adjustments[adjustmentCursor] = adjustment;
+        adjustmentCursor = (adjustmentCursor + 1) % adjustmentLimit;
+    }
+    if (listener) listener(adjustment);
+}
+
+void FrameGovernor::record(double stepMs) {
+    frame++;
+    history[historyCursor] = stepMs;
+    historyCursor = (historyCursor + 1) % history.size();
+    historyCount = std::min(historyCount + 1, history.size());
+    averageMs = historyCount == 1 ? stepMs : averageMs + smoothing * (stepMs - averageMs);
+    
+    if (cooldown > 0) cooldown--;
+    
+    bool spike = stepMs > 2.0 * budgetMs;
+    bool overrun = stepMs > budgetMs || averageMs > budgetMs;
+    if (overrun) {
+        calmFrames = 0;
+        if (cooldown > 0 && !spike) return;
+        
+        for (auto& knob : knobs) {
+            if (knob.value > knob.minValue) {
+                adjust(knob, std::max(knob.minValue, knob.value - knob.step), stepMs);
+                cooldown = cooldownFrames;
+                break;
+            }
+        }
+        return;
+    }
+    
+    if (averageMs >= budgetMs * recoverRatio) {
+        calmFrames = 0;
+        return;
+    }
+    
+    if (++calmFrames < recoverFrames) return;
+    calmFrames = 0;
+    
+    for (auto it = knobs.rbegin(); it != knobs.rend(); ++it) {
+        if (it->value < it->maxValue) {
+            adjust(*it, std::min(it->maxValue, it->value + it->step), stepMs);
+            break;
+        }
+    }
+}
+
+double FrameGovernor::percentile(double fraction) const {
+    if (historyCount == 0) return 0.0;
+    
+    sorted.assign(history.begin(), history.begin() + historyCount);
+    size_t rank = static_cast<size_t>(std::ceil(fraction * historyCount));
+    rank = std::min(std::max(rank, size_t(1)), historyCount) - 1;
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+    return sorted[rank];
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct GovernorKnob {
+    std::string name;
+    float value;
+    float minValue;
+    float maxValue;
+    float step;
+    std::function<void(float)> apply;
+};
+
+struct GovernorAdjustment {
+    uint64_t frame;
+    std::string knob;
+    float from;
+    float to;
+    double stepMs;
+    double averageMs;
+};
+
+class FrameGovernor {
+private:
+    using Clock = std::chrono::steady_clock;
+    
+    std::vector<GovernorKnob> knobs;
+    std::vector<GovernorAdjustment> adjustments;
+    std::vector<double> history;
+    size_t adjustmentLimit;
+    size_t adjustmentCursor;
+    mutable std::vector<double> sorted;
+    std::function<void(const GovernorAdjustment&)> listener;
+    size_t historyCursor;
+    size_t historyCount;
+    
+    double budgetMs;
+    double averageMs;
+    double smoothing;
+    double recoverRatio;
+    int recoverFrames;
+    int cooldownFrames;
+    int calmFrames;
+    int cooldown;
+    uint64_t frame;
+    Clock::time_point stepStart;
+    
+    void adjust(GovernorKnob& knob, float value, double stepMs);
+    
+public:
+    explicit FrameGovernor(double budgetMs, size_t historySize = 1024, size_t adjustmentLimit = 256);
+    
+    size_t addKnob(const std::string& name, float value, float minValue, float maxValue, float step,
+                   std::function<void(float)> apply);
+    
+    void beginStep() { stepStart = Clock::now(); }
+    void endStep();
+    void record(double stepMs);
+    
+    double percentile(double fraction) const;
+    double getP99() const { return percentile(0.99); }
+    
+    void setBudget(double ms) { budgetMs = ms; }
+    void setSmoothing(double alpha) { smoothing = alpha; }
+    void setRecovery(double ratio, int frames) { recoverRatio = ratio; recoverFrames = frames; }
+    void setCooldown(int frames) { cooldownFrames = frames; }
+    void setListener(std::function<void(const GovernorAdjustment&)> fn) { listener = std::move(fn); }
+    
+    double getBudget() const { return budgetMs; }
+    double getAverageMs() const { return averageMs; }
+    uint64_t getFrame() const { return frame; }
+    const std::vector<GovernorKnob>& getKnobs() const { return knobs; }
+    size_t getAdjustmentCount() const { return adjustments.size(); }
+    const GovernorAdjustment& getAdjustment(size_t i) const {
+        return adjustments[(adjustmentCursor + i) % adjustments.size()];
+    }
+};
\ No newline at end of file
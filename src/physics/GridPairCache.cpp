@@ -0,0 +1,95 @@
+#include "GridPairCache.h"
+
+void GridPairCache::markStale(const SpatialGrid& grid, uint32_t cell) {
+    int width = grid.getWidth();
+    int height = grid.getHeight();
+    int gx = static_cast<int>(cell) / height;
+    int gy = static_cast<int>(cell) % height;
+    
+    for (int nx = gx - 1; nx <= gx + 1; nx++) {
+        if (nx < 0 || nx >= width) continue;
+        for (int ny = gy - 1; ny <= gy + 1; ny++) {
+            if (ny < 0 || ny >= height) continue;
+            uint32_t neighbor = static_cast<uint32_t>(nx * height + ny);
+            if (stale[neighbor]) continue;
+            stale[neighbor] = 1;
+            staleCells.push_back(neighbor);
+        }
+    }
+}
+
+void GridPairCache::rebuildCell(const SpatialGrid& grid, const std::vector<Particle>& particles, uint32_t cell) {
+    const Particle* base = particles.data();
+    std::vector<BodyPair>& pairs = cellPairs[cell];
+    pairCount -= pairs.size();
+    pairs.clear();
+    
+    int height = grid.getHeight();
+    int gx = static_cast<int>(cell) / height;
+    int gy = static_cast<int>(cell) % height;
+    
+    const std::vector<Particle*>& residents = grid.getCell(cell);
+    for (int nx = gx - 1; nx <= gx + 1; nx++) {
+        if (nx < 0 || nx >= grid.getWidth()) continue;
+        for (int ny = gy - 1; ny <= gy + 1; ny++) {
+            if (ny < 0 || ny >= height) continue;
+            const std::vector<Particle*>& neighbors = grid.getCell(static_cast<uint32_t>(nx * height + ny));
+            for (const Particle* particle : residents) {
+                float x = particle->position.x;
+                float y = particle->position.y;
+                float radius = particle->radius + skin;
+                for (const Particle* other : neighbors) {
+                    if (other <= particle) continue;
+                    float dx = other->position.x - x;
+                    float dy = other->position.y - y;
+                    float reach = radius + other->radius;
+                    if (dx * dx + dy * dy >= reach * reach) continue;
+                    pairs.push_back({ static_cast<uint32_t>(particle - base), static_cast<uint32_t>(other - base) });
+                }
+            }
+        }
+    }
+    pairCount += pairs.size();
+}
+
+void GridPairCache::refresh(SpatialGrid& grid, const std::vector<Particle>& particles) {
+    size_t cellCount = grid.getCellCount();
+    refreshedCells = 0;
+    
+    if (cellPairs.size() != cellCount || referencePositions.size() != particles.size()) {
+        cellPairs.assign(cellCount, std::vector<BodyPair>());
+        stale.assign(cellCount, 0);
+        staleCells.clear();
+        pairCount = 0;
+        referencePositions.resize(particles.size());
+        for (size_t i = 0; i < particles.size(); i++) {
+            referencePositions[i] = particles[i].position;
+        }
+        for (uint32_t cell = 0; cell < cellCount; cell++) {
+            rebuildCell(grid, particles, cell);
+        }
+        refreshedCells = cellCount;
+        grid.clearDirty();
+        return;
+    }
+    
+    for (uint32_t dirty : grid.getDirtyCells()) {
+        markStale(grid, dirty);
+    }
+    
+    float limit = skin * 0.25f;
+    float limitSquared = limit * limit;
+    for (size_t i = 0; i < particles.size(); i++) {
+        if ((particles[i].position - referencePositions[i]).magnitudeSquared() <= limitSquared) continue;
+        referencePositions[i] = particles[i].position;
+        markStale(grid, static_cast<uint32_t>(grid.getParticleCell(i)));
+    }
+    
+    for (uint32_t cell : staleCells) {
+        rebuildCell(grid, particles, cell);
+        stale[cell] = 0;
+    }
+    refreshedCells = staleCells.size();
+    staleCells.clear();
+    grid.clearDirty();
+}
\ No newline at end of file
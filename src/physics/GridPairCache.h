@@ -0,0 +1,38 @@
+#pragma once
+#include "Collision.h"
+#include <cstdint>
+#include <vector>
+
+class GridPairCache {
+private:
+    std::vector<std::vector<BodyPair>> cellPairs;
+    std::vector<Vector2> referencePositions;
+    std::vector<uint8_t> stale;
+    std::vector<uint32_t> staleCells;
+    float skin;
+    size_t refreshedCells;
+    size_t pairCount;
+    
+    void markStale(const SpatialGrid& grid, uint32_t cell);
+    void rebuildCell(const SpatialGrid& grid, const std::vector<Particle>& particles, uint32_t cell);
+    
+public:
+    explicit GridPairCache(float skin = 2.0f) : skin(skin), refreshedCells(0), pairCount(0) {}
+    
+    void refresh(SpatialGrid& grid, const std::vector<Particle>& particles);
+    void invalidate() { cellPairs.clear(); }
+    
+    template <typename Fn>
+    void forEachPair(Fn&& fn) const {
+        for (const auto& pairs : cellPairs) {
+            for (const BodyPair& pair : pairs) {
+                fn(pair.a, pair.b);
+            }
+        }
+    }
+    
+    void setSkin(float s) { skin = s; cellPairs.clear(); }
+    float getSkin() const { return skin; }
+    size_t getRefreshedCells() const { return refreshedCells; }
+    size_t getPairCount() const { return pairCount; }
+};
\ No newline at end of file
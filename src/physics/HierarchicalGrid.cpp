@@ -0,0 +1,95 @@
+#include "HierarchicalGrid.h"
+#include <cmath>
+
+HierarchicalGrid::HierarchicalGrid(float worldWidth, float worldHeight, float baseCellSize)
+    : worldWidth(worldWidth), worldHeight(worldHeight), baseCellSize(baseCellSize),
+      minCellSize(std::max(worldWidth, worldHeight) / 2048.0f), tunePercentile(0.1f),
+      autoTune(baseCellSize <= 0.0f), retuneCount(0) {
+    if (this->baseCellSize <= 0.0f) this->baseCellSize = 50.0f;
+}
+
+void HierarchicalGrid::tune(const std::vector<Particle>& particles) {
+    if (particles.empty()) return;
+    
+    radii.resize(particles.size());
+    for (size_t i = 0; i < particles.size(); i++) {
+        radii[i] = particles[i].radius;
+    }
+    size_t rank = static_cast<size_t>(tunePercentile * (radii.size() - 1));
+    std::nth_element(radii.begin(), radii.begin() + rank, radii.end());
+    
+    float target = std::max(minCellSize, 2.0f * radii[rank]);
+    if (target < baseCellSize * 0.8f || target > baseCellSize * 1.25f) {
+        baseCellSize = target;
+        retuneCount++;
+    }
+}
+
+uint8_t HierarchicalGrid::levelFor(float radius) const {
+    int level = 0;
+    float cell = baseCellSize;
+    while (level < MAX_LEVELS - 1 && cell < 2.0f * radius) {
+        cell *= 2.0f;
+        level++;
+    }
+    return static_cast<uint8_t>(level);
+}
+
+void HierarchicalGrid::layoutLevels(int count) {
+    levels.resize(count);
+    uint32_t cells = 0;
+    float cellSize = baseCellSize;
+    for (int l = 0; l < count; l++) {
+        Level& level = levels[l];
+        level.cellSize = cellSize;
+        level.inverseCellSize = 1.0f / cellSize;
+        level.width = static_cast<int>(worldWidth / cellSize) + 1;
+        level.height = static_cast<int>(worldHeight / cellSize) + 1;
+        level.firstCell = cells;
+        level.count = 0;
+        level.maxRadius = 0.0f;
+        cells += static_cast<uint32_t>(level.width * level.height);
+        cellSize *= 2.0f;
+    }
+    cellStart.assign(cells + 1, 0);
+}
+
+void HierarchicalGrid::build(const std::vector<Particle>& particles) {
+    if (autoTune) tune(particles);
+    
+    size_t n = particles.size();
+    particleLevel.resize(n);
+    particleCell.resize(n);
+    
+    int levelCount = 1;
+    for (size_t i = 0; i < n; i++) {
+        particleLevel[i] = levelFor(particles[i].radius);
+        levelCount = std::max(levelCount, particleLevel[i] + 1);
+    }
+    layoutLevels(levelCount);
+    
+    for (size_t i = 0; i < n; i++) {
+        const Particle& p = particles[i];
+        Level& level = levels[particleLevel[i]];
+        int x = clampCell(p.position.x, level.inverseCellSize, level.width);
+        int y = clampCell(p.position.y, level.inverseCellSize, level.height);
+        uint32_t cell = level.firstCell + static_cast<uint32_t>(y * level.width + x);
+        particleCell[i] = cell;
+        cellStart[cell + 1]++;
+        level.count++;
+        level.maxRadius = std::max(level.maxRadius, p.radius);
+    }
+    
+    for (size_t c = 1; c < cellStart.size(); c++) {
+        cellStart[c] += cellStart[c - 1];
+    }
+    
+    entries.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        entries[cellStart[particleCell[i]]++] = static_cast<uint32_t>(i);
+    }
+    for (size_t c = cellStart.size() - 1; c > 0; c--) {
+        cellStart[c] = cellStart[c - 1];
+    }
+    cellStart[0] = 0;
+}
\ No newline at end of file
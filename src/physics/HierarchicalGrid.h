@@ -0,0 +1,88 @@
+#pragma once
+#include "Particle.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+class HierarchicalGrid {
+private:
+    struct Level {
+        float cellSize;
+        float inverseCellSize;
+        int width;
+        int height;
+        uint32_t firstCell;
+        uint32_t count;
+        float maxRadius;
+    };
+    
+    std::vector<Level> levels;
+    std::vector<uint32_t> cellStart;
+    std::vector<uint32_t> entries;
+    std::vector<uint32_t> particleCell;
+    std::vector<uint8_t> particleLevel;
+    std::vector<float> radii;
+    
+    float worldWidth;
+    float worldHeight;
+    float baseCellSize;
+    float minCellSize;
+    float tunePercentile;
+    bool autoTune;
+    size_t retuneCount;
+    
+    void tune(const std::vector<Particle>& particles);
+    void layoutLevels(int count);
+    uint8_t levelFor(float radius) const;
+    
+    static int clampCell(float coordinate, float inverseCellSize, int size) {
+        int c = static_cast<int>(coordinate * inverseCellSize);
+        return std::max(0, std::min(c, size - 1));
+    }
+    
+public:
+    static const int MAX_LEVELS = 12;
+    
+    HierarchicalGrid(float worldWidth, float worldHeight, float baseCellSize = 0.0f);
+    
+    void build(const std::vector<Particle>& particles);
+    
+    template <typename Fn>
+    void forEachCandidate(const std::vector<Particle>& particles, uint32_t i, Fn&& fn) const {
+        const Particle& p = particles[i];
+        uint32_t ownLevel = particleLevel[i];
+        
+        for (uint32_t l = ownLevel; l < levels.size(); l++) {
+            const Level& level = levels[l];
+            if (level.count == 0) continue;
+            
+            float reach = p.radius + level.maxRadius;
+            int x0 = clampCell(p.position.x - reach, level.inverseCellSize, level.width);
+            int x1 = clampCell(p.position.x + reach, level.inverseCellSize, level.width);
+            int y0 = clampCell(p.position.y - reach, level.inverseCellSize, level.height);
+            int y1 = clampCell(p.position.y + reach, level.inverseCellSize, level.height);
+            
+            for (int y = y0; y <= y1; y++) {
+                uint32_t row = level.firstCell + static_cast<uint32_t>(y * level.width);
+                for (int x = x0; x <= x1; x++) {
+                    uint32_t cell = row + static_cast<uint32_t>(x);
+                    for (uint32_t k = cellStart[cell]; k < cellStart[cell + 1]; k++) {
+                        uint32_t j = entries[k];
+                        if (l == ownLevel && j <= i) continue;
+                        fn(j);
+                    }
+                }
+            }
+        }
+    }
+    
+    void setBaseCellSize(float size) { baseCellSize = size; autoTune = size <= 0.0f; }
+    void setTunePercentile(float fraction) { tunePercentile = fraction; }
+    
+    size_t getLevelCount() const { return levels.size(); }
+    float getBaseCellSize() const { return baseCellSize; }
+    float getCellSize(size_t level) const { return levels[level].cellSize; }
+    size_t getLevelPopulation(size_t level) const { return levels[level].count; }
+    uint8_t getLevel(size_t particle) const { return particleLevel[particle]; }
+    size_t getRetuneCount() const { return retuneCount; }
+};
\ No newline at end of file
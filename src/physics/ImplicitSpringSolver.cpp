@@ -0,0 +1,252 @@
+#include "ImplicitSpringSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+static const uint32_t unmapped = 0xFFFFFFFFu;
+
+ImplicitSpringSolver::ImplicitSpringSolver(int maxIterations, float tolerance)
+    : patternBase(nullptr), patternParticles(0), patternSprings(0), patternValid(false),
+      maxIterations(maxIterations), tolerance(tolerance), grain(2048),
+      lastIterations(0), lastResidual(0.0f), patternBuilds(0) {}
+
+uint32_t ImplicitSpringSolver::findSlot(uint32_t row, uint32_t column) const {
+    auto begin = columns.begin() + rowStart[row];
+    auto end = columns.begin() + rowStart[row + 1];
+    return static_cast<uint32_t>(std::lower_bound(begin, end, column) - columns.begin());
+}
+
+void ImplicitSpringSolver::buildPattern(const std::vector<Particle>& particles,
+                                        const std::vector<SpringConstraint>& springs) {
+    const Particle* base = particles.data();
+    localIndex.assign(particles.size(), unmapped);
+    particleIndex.clear();
+    
+    auto mapParticle = [&](const Particle* p) {
+        uint32_t global = static_cast<uint32_t>(p - base);
+        if (localIndex[global] == unmapped) {
+            localIndex[global] = static_cast<uint32_t>(particleIndex.size());
+            particleIndex.push_back(global);
+        }
+        return localIndex[global];
+    };
+    
+    std::vector<std::pair<uint32_t, uint32_t>> entries;
+    entries.reserve(springs.size() * 2);
+    for (const auto& spring : springs) {
+        uint32_t a = mapParticle(spring.getParticleA());
+        uint32_t b = mapParticle(spring.getParticleB());
+        if (a == b) continue;
+        entries.push_back({ a, b });
+        entries.push_back({ b, a });
+    }
+    size_t rows = particleIndex.size();
+    for (uint32_t i = 0; i < rows; i++) {
+        entries.push_back({ i, i });
+    }
+    
+    std::sort(entries.begin(), entries.end());
+    entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+    
+    rowStart.assign(rows + 1, 0);
+    columns.resize(entries.size());
+    for (size_t k = 0; k < entries.size(); k++) {
+        rowStart[entries[k].first + 1]++;
+        columns[k] = entries[k].second;
+    }
+    for (size_t i = 0; i < rows; i++) {
+        rowStart[i + 1] += rowStart[i];
+    }
+    
+    diagonal.resize(rows);
+    for (uint32_t i = 0; i < rows; i++) {
+        diagonal[i] = findSlot(i, i);
+    }
+    
+    slots.resize(springs.size());
+    for (size_t s = 0; s < springs.size(); s++) {
+        uint32_t a = localIndex[springs[s].getParticleA() - base];
+        uint32_t b = localIndex[springs[s].getParticleB() - base];
+        slots[s] = { a, b, diagonal[a], diagonal[b], findSlot(a, b), findSlot(b, a) };
+    }
+    
+    values.resize(columns.size());
+    preconditioner.resize(rows);
+    fixed.resize(rows);
+    rhs.resize(rows);
+    solution.assign(rows, Vector2(0, 0));
+    residual.resize(rows);
+    preconditioned.resize(rows);
+    direction.resize(rows);
+    product.resize(rows);
+    partials.resize((rows + grain - 1) / grain);
+    
+    patternBase = base;
+    patternParticles = particles.size();
+    patternSprings = springs.size();
+    patternValid = true;
+    patternBuilds++;
+}
+
+void ImplicitSpringSolver::assemble(const std::vector<Particle>& particles,
+                                    const std::vector<SpringConstraint>& springs, float dt) {
+    size_t rows = particleIndex.size();
+    std::fill(values.begin(), values.end(), MatrixBlock{ 0.0f, 0.0f, 0.0f, 0.0f });
+    
+    for (size_t i = 0; i < rows; i++) {
+        const Particle& p = particles[particleIndex[i]];
+        fixed[i] = p.hasInfiniteMass() ? 1 : 0;
+        float m = fixed[i] ? 1.0f : p.getMass();
+        values[diagonal[i]] = { m, 0.0f, 0.0f, m };
+        rhs[i] = fixed[i] ? Vector2(0, 0) : p.forceAccumulator * dt;
+    }
+    
+    float h2 = dt * dt;
+    for (size_t s = 0; s < springs.size(); s++) {
+        const SpringConstraint& spring = springs[s];
+        const SpringSlots& slot = slots[s];
+        if (slot.a == slot.b) continue;
+        
+        const Particle& pa = *spring.getParticleA();
+        const Particle& pb = *spring.getParticleB();
+        Vector2 delta = pb.position - pa.position;
+        float length = delta.magnitude();
+        if (length == 0.0f) continue;
+        
+        Vector2 n = delta / length;
+        float k = spring.getStiffness();
+        float c = spring.getDamping();
+        Vector2 relativeVelocity = pb.velocity - pa.velocity;
+        Vector2 force = n * (k * (length - spring.getRestLength()) + c * relativeVelocity.dot(n));
+        
+        float lateral = k * std::max(0.0f, 1.0f - spring.getRestLength() / length);
+        float axial = k - lateral;
+        MatrixBlock stiffness = { axial * n.x * n.x + lateral, axial * n.x * n.y,
+                                  axial * n.y * n.x, axial * n.y * n.y + lateral };
+        MatrixBlock coupling = { dt * c * n.x * n.x + h2 * stiffness.xx, dt * c * n.x * n.y + h2 * stiffness.xy,
+                                 dt * c * n.y * n.x + h2 * stiffness.yx, dt * c * n.y * n.y + h2 * stiffness.yy };
+        Vector2 stiffnessVelocity = stiffness * relativeVelocity;
+        
+        bool freeA = !fixed[slot.a];
+        bool freeB = !fixed[slot.b];
+        if (freeA) {
+            rhs[slot.a] += (force + stiffnessVelocity * dt) * dt;
+            MatrixBlock& aa = values[slot.aa];
+            aa.xx += coupling.xx; aa.xy += coupling.xy; aa.yx += coupling.yx; aa.yy += coupling.yy;
+        }
+        if (freeB) {
+            rhs[slot.b] -= (force + stiffnessVelocity * dt) * dt;
+            MatrixBlock& bb = values[slot.bb];
+            bb.xx += coupling.xx; bb.xy += coupling.xy; bb.yx += coupling.yx; bb.yy += coupling.yy;
+        }
+        if (freeA && freeB) {
+            MatrixBlock& ab = values[slot.ab];
+            MatrixBlock& ba = values[slot.ba];
+            ab.xx -= coupling.xx; ab.xy -= coupling.xy; ab.yx -= coupling.yx; ab.yy -= coupling.yy;
+            ba.xx -= coupling.xx; ba.xy -= coupling.xy; ba.yx -= coupling.yx; ba.yy -= coupling.yy;
+        }
+    }
+    
+    for (size_t i = 0; i < rows; i++) {
+        const MatrixBlock& d = values[diagonal[i]];
+        float det = d.xx * d.yy - d.xy * d.yx;
+        float inv = det != 0.0f ? 1.0f / det : 0.0f;
+        preconditioner[i] = { d.yy * inv, -d.xy * inv, -d.yx * inv, d.xx * inv };
+    }
+}
+
+void ImplicitSpringSolver::multiply(const std::vector<Vector2>& in, std::vector<Vector2>& out, ThreadPool& pool) {
+    pool.parallelFor(particleIndex.size(), grain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            Vector2 sum(0, 0);
+            for (uint32_t k = rowStart[i]; k < rowStart[i + 1]; k++) {
+                sum += values[k] * in[columns[k]];
+            }
+            out[i] = sum;
+        }
+    });
+}
+
+double ImplicitSpringSolver::dot(const std::vector<Vector2>& a, const std::vector<Vector2>& b, ThreadPool& pool) {
+    pool.parallelFor(a.size(), grain, [&](size_t begin, size_t end) {
+        double sum = 0.0;
+        for (size_t i = begin; i < end; i++) {
+            sum += static_cast<double>(a[i].x) * b[i].x + static_cast<double>(a[i].y) * b[i].y;
+        }
+        partials[begin / grain] = sum;
+    });
+    
+    double total = 0.0;
+    for (double partial : partials) {
+        total += partial;
+    }
+    return total;
+}
+
+void ImplicitSpringSolver::solve(ThreadPool& pool) {
+    size_t rows = particleIndex.size();
+    
+    multiply(solution, product, pool);
+    pool.parallelFor(rows, grain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            if (fixed[i]) solution[i] = Vector2(0, 0);
+            residual[i] = fixed[i] ? Vector2(0, 0) : rhs[i] - product[i];
+            preconditioned[i] = preconditioner[i] * residual[i];
+            direction[i] = preconditioned[i];
+        }
+    });
+    
+    double target = static_cast<double>(tolerance) * tolerance * std::max(dot(rhs, rhs, pool), 1e-12);
+    double rz = dot(residual, preconditioned, pool);
+    double rr = dot(residual, residual, pool);
+    
+    int iteration = 0;
+    while (iteration < maxIterations && rr > target) {
+        multiply(direction, product, pool);
+        double pq = dot(direction, product, pool);
+        if (pq <= 0.0) break;
+        
+        float alpha = static_cast<float>(rz / pq);
+        pool.parallelFor(rows, grain, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                solution[i] += direction[i] * alpha;
+                residual[i] -= product[i] * alpha;
+                preconditioned[i] = preconditioner[i] * residual[i];
+            }
+        });
+        iteration++;
+        
+        rr = dot(residual, residual, pool);
+        double rzNext = dot(residual, preconditioned, pool);
+        float beta = static_cast<float>(rzNext / rz);
+        rz = rzNext;
+        pool.parallelFor(rows, grain, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                direction[i] = preconditioned[i] + direction[i] * beta;
+            }
+        });
+    }
+    
+    lastIterations = iteration;
+    lastResidual = static_cast<float>(std::sqrt(rr));
+}
+
+void ImplicitSpringSolver::step(std::vector<Particle>& particles, const std::vector<SpringConstraint>& springs,
+                                float dt, ThreadPool& pool) {
+    if (springs.empty()) return;
+    
+    if (!patternValid || patternBase != particles.data() || patternParticles != particles.size() ||
+        patternSprings != springs.size()) {
+        buildPattern(particles, springs);
+    }
+    
+    assemble(particles, springs, dt);
+    solve(pool);
+    
+    for (size_t i = 0; i < particleIndex.size(); i++) {
+        if (fixed[i]) continue;
+        Particle& p = particles[particleIndex[i]];
+        p.velocity += solution[i];
+        p.clearForces();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Particle.h"
+#include "Vector2.h"
+#include "Constraint.h"
+#include "ThreadPool.h"
+
+struct MatrixBlock {
+    float xx, xy;
+    float yx, yy;
+    
+    Vector2 operator*(const Vector2& v) const { return Vector2(xx * v.x + xy * v.y, yx * v.x + yy * v.y); }
+};
+
+class ImplicitSpringSolver {
+private:
+    struct SpringSlots {
+        uint32_t a;
+        uint32_t b;
+        uint32_t aa;
+        uint32_t bb;
+        uint32_t ab;
+        uint32_t ba;
+    };
+    
+    std::vector<uint32_t> localIndex;
+    std::vector<uint32_t> particleIndex;
+    std::vector<uint32_t> rowStart;
+    std::vector<uint32_t> columns;
+    std::vector<uint32_t> diagonal;
+    std::vector<MatrixBlock> values;
+    std::vector<SpringSlots> slots;
+    std::vector<MatrixBlock> preconditioner;
+    std::vector<uint8_t> fixed;
+    
+    std::vector<Vector2> rhs;
+    std::vector<Vector2> solution;
+    std::vector<Vector2> residual;
+    std::vector<Vector2> preconditioned;
+    std::vector<Vector2> direction;
+    std::vector<Vector2> product;
+    std::vector<double> partials;
+    
+    const Particle* patternBase;
+    size_t patternParticles;
+    size_t patternSprings;
+    bool patternValid;
+    
+    int maxIterations;
+    float tolerance;
+    size_t grain;
+    int lastIterations;
+    float lastResidual;
+    size_t patternBuilds;
+    
+    uint32_t findSlot(uint32_t row, uint32_t column) const;
+    void buildPattern(const std::vector<Particle>& particles, const std::vector<SpringConstraint>& springs);
+    void assemble(const std::vector<Particle>& particles, const std::vector<SpringConstraint>& springs, float dt);
+    void multiply(const std::vector<Vector2>& in, std::vector<Vector2>& out, ThreadPool& pool);
+    double dot(const std::vector<Vector2>& a, const std::vector<Vector2>& b, ThreadPool& pool);
+    void solve(ThreadPool& pool);
+    
+public:
+    ImplicitSpringSolver(int maxIterations = 50, float tolerance = 1e-4f);
+    
+    void step(std::vector<Particle>& particles, const std::vector<SpringConstraint>& springs,
+              float dt, ThreadPool& pool);
+    void invalidate() { patternValid = false; }
+    
+    void setMaxIterations(int iterations) { maxIterations = iterations; }
+    void setTolerance(float t) { tolerance = t; }
+    
+    int getLastIterations() const { return lastIterations; }
+    float getLastResidual() const { return lastResidual; }
+    size_t getPatternBuilds() const { return patternBuilds; }
+    size_t getRowCount() const { return particleIndex.size(); }
+    size_t getNonZeroBlocks() const { return columns.size(); }
+};
\ No newline at end of file
@@ -0,0 +1,134 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+struct UniformField {
+    float gravityX;
+    float gravityY;
+    
+    UniformField(float gx = 0.0f, float gy = 400.0f) : gravityX(gx), gravityY(gy) {}
+    
+    void acceleration(float x, float y, float vx, float vy, float& ax, float& ay) const {
+        (void)x; (void)y; (void)vx; (void)vy;
+        ax = gravityX;
+        ay = gravityY;
+    }
+    
+    float potential(float x, float y) const { return -(gravityX * x + gravityY * y); }
+};
+
+struct HarmonicField {
+    float centerX;
+    float centerY;
+    float stiffness;
+    float gravityX;
+    float gravityY;
+    
+    HarmonicField(float cx = 0.0f, float cy = 0.0f, float k = 1.0f, float gx = 0.0f, float gy = 0.0f)
+        : centerX(cx), centerY(cy), stiffness(k), gravityX(gx), gravityY(gy) {}
+    
+    void acceleration(float x, float y, float vx, float vy, float& ax, float& ay) const {
+        (void)vx; (void)vy;
+        ax = gravityX - stiffness * (x - centerX);
+        ay = gravityY - stiffness * (y - centerY);
+    }
+    
+    float potential(float x, float y) const {
+        float dx = x - centerX;
+        float dy = y - centerY;
+        return 0.5f * stiffness * (dx * dx + dy * dy) - (gravityX * x + gravityY * y);
+    }
+};
+
+struct SymplecticEuler {
+    static std::string name() { return "symplectic-euler"; }
+    
+    template <typename Field>
+    static void step(float& x, float& y, float& vx, float& vy, const Field& field, float dt) {
+        float ax, ay;
+        field.acceleration(x, y, vx, vy, ax, ay);
+        vx += ax * dt;
+        vy += ay * dt;
+        x += vx * dt;
+        y += vy * dt;
+    }
+};
+
+struct VelocityVerlet {
+    static std::string name() { return "velocity-verlet"; }
+    
+    template <typename Field>
+    static void step(float& x, float& y, float& vx, float& vy, const Field& field, float dt) {
+        float ax, ay;
+        field.acceleration(x, y, vx, vy, ax, ay);
+        x += (vx + 0.5f * ax * dt) * dt;
+        y += (vy + 0.5f * ay * dt) * dt;
+        
+        float nextAx, nextAy;
+        field.acceleration(x, y, vx + ax * dt, vy + ay * dt, nextAx, nextAy);
+        vx += 0.5f * (ax + nextAx) * dt;
+        vy += 0.5f * (ay + nextAy) * dt;
+    }
+};
+
+struct RK4 {
+    static std::string name() { return "rk4"; }
+    
+    template <typename Field>
+    static void step(float& x, float& y, float& vx, float& vy, const Field& field, float dt) {
+        float half = 0.5f * dt;
+        
+        float ax1, ay1;
+        field.acceleration(x, y, vx, vy, ax1, ay1);
+        
+        float vx2 = vx + ax1 * half, vy2 = vy + ay1 * half;
+        float ax2, ay2;
+        field.acceleration(x + vx * half, y + vy * half, vx2, vy2, ax2, ay2);
+        
+        float vx3 = vx + ax2 * half, vy3 = vy + ay2 * half;
+        float ax3, ay3;
+        field.acceleration(x + vx2 * half, y + vy2 * half, vx3, vy3, ax3, ay3);
+        
+        float vx4 = vx + ax3 * dt, vy4 = vy + ay3 * dt;
+        float ax4, ay4;
+        field.acceleration(x + vx3 * dt, y + vy3 * dt, vx4, vy4, ax4, ay4);
+        
+        float sixth = dt / 6.0f;
+        x += (vx + 2.0f * vx2 + 2.0f * vx3 + vx4) * sixth;
+        y += (vy + 2.0f * vy2 + 2.0f * vy3 + vy4) * sixth;
+        vx += (ax1 + 2.0f * ax2 + 2.0f * ax3 + ax4) * sixth;
+        vy += (ay1 + 2.0f * ay2 + 2.0f * ay3 + ay4) * sixth;
+    }
+};
+
+template <typename Integrator, int RetainPerMille = 995, int AngularRetainPerMille = 1000>
+struct Damped {
+    static std::string name() { return "damped-" + Integrator::name(); }
+    
+    template <typename Field>
+    static void step(float& x, float& y, float& vx, float& vy, const Field& field, float dt) {
+        const float retain = RetainPerMille / 1000.0f;
+        Integrator::step(x, y, vx, vy, field, dt);
+        vx *= retain;
+        vy *= retain;
+    }
+};
+
+template <typename Integrator>
+struct IntegratorTraits {
+    static float retain(uint32_t steps) { (void)steps; return 1.0f; }
+    static float angularRetain(uint32_t steps) { (void)steps; return 1.0f; }
+};
+
+template <typename Integrator, int RetainPerMille, int AngularRetainPerMille>
+struct IntegratorTraits<Damped<Integrator, RetainPerMille, AngularRetainPerMille>> {
+    static float retain(uint32_t steps) {
+        return std::pow(RetainPerMille / 1000.0f, static_cast<float>(steps)) * IntegratorTraits<Integrator>::retain(steps);
+    }
+    
+    static float angularRetain(uint32_t steps) {
+        return std::pow(AngularRetainPerMille / 1000.0f, static_cast<float>(steps)) *
+               IntegratorTraits<Integrator>::angularRetain(steps);
+    }
+};
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include "JacobiContactSolver.h"
+#include <algorithm>
+
+JacobiContactSolver::JacobiContactSolver()
+    : iterations(4), relaxation(1.0f) {}
+
+void JacobiContactSolver::load(const std::vector<Contact>& contacts, const std::vector<Particle>& particles) {
+    size_t n = contacts.size();
+    bodyA.resize(n);
+    bodyB.resize(n);
+    normalX.resize(n);
+    normalY.resize(n);
+    penetration.resize(n);
+    baseSeparation.resize(n);
+    
+    const Particle* base = particles.data();
+    for (size_t k = 0; k < n; k++) {
+        const Contact& contact = contacts[k];
+        bodyA[k] = static_cast<uint32_t>(contact.particleA - base);
+        bodyB[k] = static_cast<uint32_t>(contact.particleB - base);
+        normalX[k] = contact.normal.x;
+        normalY[k] = contact.normal.y;
+        penetration[k] = contact.penetration;
+        
+        Vector2 d = contact.particleB->position - contact.particleA->position;
+        baseSeparation[k] = d.x * contact.normal.x + d.y * contact.normal.y;
+    }
+    
+    deltaVX.resize(2 * n);
+    deltaVY.resize(2 * n);
+    deltaPX.resize(2 * n);
+    deltaPY.resize(2 * n);
+}
+
+void JacobiContactSolver::buildEndpoints(size_t particleCount) {
+    size_t n = bodyA.size();
+    endpointOffsets.assign(particleCount + 1, 0);
+    for (size_t k = 0; k < n; k++) {
+        endpointOffsets[bodyA[k] + 1]++;
+        endpointOffsets[bodyB[k] + 1]++;
+    }
+    for (size_t i = 0; i < particleCount; i++) {
+        endpointOffsets[i + 1] += endpointOffsets[i];
+    }
+    
+    endpoints.resize(2 * n);
+    std::vector<uint32_t> cursor(endpointOffsets.begin(), endpointOffsets.end() - 1);
+    for (size_t k = 0; k < n; k++) {
+        endpoints[cursor[bodyA[k]]++] = static_cast<uint32_t>(2 * k);
+        endpoints[cursor[bodyB[k]]++] = static_cast<uint32_t>(2 * k + 1);
+    }
+}
+
+size_t JacobiContactSolver::prepare(const std::vector<Contact>& contacts, const std::vector<Particle>& particles) {
+    load(contacts, particles);
+    buildEndpoints(particles.size());
+    return contacts.size();
+}
+
+void JacobiContactSolver::computeDeltas(const std::vector<Particle>& particles, float restitution,
+                                        size_t begin, size_t end) {
+    const uint32_t* __restrict a = bodyA.data();
+    const uint32_t* __restrict b = bodyB.data();
+    const float* __restrict nx = normalX.data();
+    const float* __restrict ny = normalY.data();
+    float* __restrict dvx = deltaVX.data();
+    float* __restrict dvy = deltaVY.data();
+    float* __restrict dpx = deltaPX.data();
+    float* __restrict dpy = deltaPY.data();
+    
+    for (size_t k = begin; k < end; k++) {
+        const Particle& pa = particles[a[k]];
+        const Particle& pb = particles[b[k]];
+        float wa = pa.getInverseMass();
+        float wb = pb.getInverseMass();
+        float w = wa + wb;
+        
+        float vx = 0.0f, vy = 0.0f, px = 0.0f, py = 0.0f;
+        if (w > 0.0f) {
+            float separatingVelocity = (pb.velocity.x - pa.velocity.x) * nx[k] +
+                                       (pb.velocity.y - pa.velocity.y) * ny[k];
+            if (separatingVelocity < 0.0f) {
+                float impulse = -(1.0f + restitution) * separatingVelocity / w;
+                vx = nx[k] * impulse;
+                vy = ny[k] * impulse;
+            }
+            
+            float separation = (pb.position.x - pa.position.x) * nx[k] +
+                               (pb.position.y - pa.position.y) * ny[k];
+            float depth = penetration[k] - (separation - baseSeparation[k]);
+            if (depth > 0.0f) {
+                float move = depth / w;
+                px = nx[k] * move;
+                py = ny[k] * move;
+            }
+        }
+        
+        dvx[2 * k] = -vx * wa;
+        dvy[2 * k] = -vy * wa;
+        dpx[2 * k] = -px * wa;
+        dpy[2 * k] = -py * wa;
+        dvx[2 * k + 1] = vx * wb;
+        dvy[2 * k + 1] = vy * wb;
+        dpx[2 * k + 1] = px * wb;
+        dpy[2 * k + 1] = py * wb;
+    }
+}
+
+void JacobiContactSolver::applyDeltas(std::vector<Particle>& particles, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        uint32_t first = endpointOffsets[i];
+        uint32_t last = endpointOffsets[i + 1];
+        if (first == last) continue;
+        
+        float vx = 0.0f, vy = 0.0f, px = 0.0f, py = 0.0f;
+        for (uint32_t slot = first; slot < last; slot++) {
+            uint32_t e = endpoints[slot];
+            vx += deltaVX[e];
+            vy += deltaVY[e];
+            px += deltaPX[e];
+            py += deltaPY[e];
+        }
+        
+        float scale = relaxation / static_cast<float>(last - first);
+        particles[i].velocity.x += vx * scale;
+        particles[i].velocity.y += vy * scale;
+        particles[i].position.x += px * scale;
+        particles[i].position.y += py * scale;
+    }
+}
+
+void JacobiContactSolver::solve(const std::vector<Contact>& contacts, std::vector<Particle>& particles,
+                                float restitution, ThreadPool& pool) {
+    if (prepare(contacts, particles) == 0) return;
+    
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        pool.parallelFor(contacts.size(), CONTACT_GRAIN, [&](size_t begin, size_t end) {
+            computeDeltas(particles, restitution, begin, end);
+        });
+        pool.parallelFor(particles.size(), PARTICLE_GRAIN, [&](size_t begin, size_t end) {
+            applyDeltas(particles, begin, end);
+        });
+    }
+}
\ No newline at end of file
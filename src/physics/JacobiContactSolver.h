@@ -0,0 +1,48 @@
+#pragma once
+#include "Particle.h"
+#include "Collision.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <vector>
+
+class JacobiContactSolver {
+private:
+    std::vector<uint32_t> bodyA;
+    std::vector<uint32_t> bodyB;
+    std::vector<float> normalX;
+    std::vector<float> normalY;
+    std::vector<float> penetration;
+    std::vector<float> baseSeparation;
+    
+    std::vector<float> deltaVX;
+    std::vector<float> deltaVY;
+    std::vector<float> deltaPX;
+    std::vector<float> deltaPY;
+    
+    std::vector<uint32_t> endpointOffsets;
+    std::vector<uint32_t> endpoints;
+    
+    int iterations;
+    float relaxation;
+    
+    void load(const std::vector<Contact>& contacts, const std::vector<Particle>& particles);
+    void buildEndpoints(size_t particleCount);
+    
+public:
+    static const size_t CONTACT_GRAIN = 4096;
+    static const size_t PARTICLE_GRAIN = 4096;
+    
+    JacobiContactSolver();
+    
+    void solve(const std::vector<Contact>& contacts, std::vector<Particle>& particles,
+               float restitution, ThreadPool& pool);
+    
+    size_t prepare(const std::vector<Contact>& contacts, const std::vector<Particle>& particles);
+    void computeDeltas(const std::vector<Particle>& particles, float restitution, size_t begin, size_t end);
+    void applyDeltas(std::vector<Particle>& particles, size_t begin, size_t end);
+    
+    void setIterations(int count) { iterations = count > 0 ? count : 1; }
+    void setRelaxation(float omega) { relaxation = omega; }
+    int getIterations() const { return iterations; }
+    float getRelaxation() const { return relaxation; }
+};
\ No newline at end of file
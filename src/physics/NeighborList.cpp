@@ -0,0 +1,53 @@
+#include "NeighborList.h"
+
+NeighborList::NeighborList(float skin)
+    : skin(skin), valid(false), rebuildCount(0) {}
+
+bool NeighborList::needsRebuild(const std::vector<Particle>& particles) const {
+    if (!valid || particles.size() != referencePositions.size()) return true;
+    
+    float limit = skin * 0.5f;
+    float limitSquared = limit * limit;
+    for (size_t i = 0; i < particles.size(); i++) {
+        if (Vector2::distanceSquared(particles[i].position, referencePositions[i]) > limitSquared) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+void NeighborList::build(std::vector<Particle>& particles, SpatialGrid& grid) {
+    size_t n = particles.size();
+    
+    grid.clear();
+    for (auto& particle : particles) {
+        grid.insert(particle);
+    }
+    
+    referencePositions.resize(n);
+    neighborStart.resize(n + 1);
+    neighborIndex.clear();
+    
+    const Particle* base = particles.data();
+    for (size_t i = 0; i < n; i++) {
+        const Particle& particle = particles[i];
+        referencePositions[i] = particle.position;
+        neighborStart[i] = static_cast<uint32_t>(neighborIndex.size());
+        
+        grid.query(particle, nearby);
+        for (Particle* other : nearby) {
+            uint32_t j = static_cast<uint32_t>(other - base);
+            if (j <= i) continue;
+            
+            float cutoff = particle.radius + other->radius + skin;
+            if (Vector2::distanceSquared(particle.position, other->position) < cutoff * cutoff) {
+                neighborIndex.push_back(j);
+            }
+        }
+    }
+    neighborStart[n] = static_cast<uint32_t>(neighborIndex.size());
+    
+    valid = true;
+    rebuildCount++;
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+#include "Particle.h"
+#include "Collision.h"
+#include <cstdint>
+#include <vector>
+
+class NeighborList {
+private:
+    float skin;
+    bool valid;
+    size_t rebuildCount;
+    
+    std::vector<uint32_t> neighborStart;
+    std::vector<uint32_t> neighborIndex;
+    std::vector<Vector2> referencePositions;
+    std::vector<Particle*> nearby;
+    
+public:
+    explicit NeighborList(float skin = 4.0f);
+    
+    bool needsRebuild(const std::vector<Particle>& particles) const;
+    void build(std::vector<Particle>& particles, SpatialGrid& grid);
+    void invalidate() { valid = false; }
+    
+    void setSkin(float s) { skin = s; valid = false; }
+    float getSkin() const { return skin; }
+    size_t getRebuildCount() const { return rebuildCount; }
+    
+    size_t size() const { return referencePositions.size(); }
+    uint32_t begin(size_t particle) const { return neighborStart[particle]; }
+    uint32_t end(size_t particle) const { return neighborStart[particle + 1]; }
+    uint32_t neighbor(uint32_t slot) const { return neighborIndex[slot]; }
+};
\ No newline at end of file
@@ -1,13 +1,14 @@
 #include "Particle.h"
-#include <limits>
 
 Particle::Particle() 
-    : position(0, 0), velocity(0, 0), acceleration(0, 0),
-      mass(1.0f), radius(5.0f), forceAccumulator(0, 0) {}
+    : inverseMass(1.0f), mass(1.0f), position(0, 0), velocity(0, 0), forceAccumulator(0, 0),
+      radius(5.0f) {}
 
 Particle::Particle(const Vector2& pos, float mass, float radius)
-    : position(pos), velocity(0, 0), acceleration(0, 0),
-      mass(mass), radius(radius), forceAccumulator(0, 0) {}
+    : inverseMass(0.0f), mass(mass), position(pos), velocity(0, 0), forceAccumulator(0, 0),
+      radius(radius) {
+    setMass(mass);
+}
 
 void Particle::addForce(const Vector2& force) {
     forceAccumulator += force;
@@ -19,15 +20,14 @@ void Particle::clearForces() {
 }
 
 void Particle::integrate(float dt) {
-    if (hasInfiniteMass()) return;  
-    
-    acceleration = forceAccumulator / mass;
-    
-    velocity += acceleration * dt;
+    integrateWith<SymplecticEuler>(dt);
+}
+
+void Particle::predict(float dt) {
+    if (hasInfiniteMass()) return;
     
+    velocity += forceAccumulator * (inverseMass * dt);
     position += velocity * dt;
-    
-    clearForces();
 }
 
 void Particle::setVelocity(const Vector2& vel) {
@@ -38,6 +38,7 @@ void Particle::setPosition(const Vector2& pos) {
     position = pos;
 }
 
-bool Particle::hasInfiniteMass() const {
-    return mass <= 0.0f;  
+void Particle::setMass(float m) {
+    mass = m;
+    inverseMass = m > 0.0f ? 1.0f / m : 0.0f;
 }
\ No newline at end of file
@@ -1,16 +1,18 @@
 #pragma once
 #include "Vector2.h"
+#include "Integrators.h"
+#include <cstdint>
 
 class Particle {
+private:
+    float inverseMass;
+    float mass;
+    
 public:
     Vector2 position;
     Vector2 velocity;
-    Vector2 acceleration;
-    
-    float mass;
-    float radius;  
-    
     Vector2 forceAccumulator;  
+    float radius;  
     
     Particle();
     Particle(const Vector2& pos, float mass, float radius = 5.0f);
@@ -19,8 +21,31 @@ public:
     void clearForces();
     void integrate(float dt);  
     
+    template <typename Integrator>
+    void integrateWith(float dt) {
+        if (hasInfiniteMass()) return;
+        
+        UniformField field(forceAccumulator.x * inverseMass, forceAccumulator.y * inverseMass);
+        Integrator::step(position.x, position.y, velocity.x, velocity.y, field, dt);
+        clearForces();
+    }
+    void predict(float dt);
+    
     void setVelocity(const Vector2& vel);
     void setPosition(const Vector2& pos);
+    void setMass(float m);
+    
+    bool hasInfiniteMass() const { return inverseMass == 0.0f; }
+    float getMass() const { return mass; }
+    float getInverseMass() const { return inverseMass; }
+};
+
+struct ParticleRemap {
+    const Particle* oldBase;
+    Particle* newBase;
+    const uint32_t* newIndex;
     
-    bool hasInfiniteMass() const;
+    Particle* operator()(Particle* p) const {
+        return newBase + newIndex[p - oldBase];
+    }
 };
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "ParticleReorder.h"
+#include <algorithm>
+#include <cmath>
+
+static const size_t chunkSize = 4096;
+static const int radixBits = 8;
+static const int radixBuckets = 1 << radixBits;
+
+uint32_t ParticleReorder::spreadBits(uint32_t v) {
+    v &= 0x0000ffff;
+    v = (v | (v << 8)) & 0x00ff00ff;
+    v = (v | (v << 4)) & 0x0f0f0f0f;
+    v = (v | (v << 2)) & 0x33333333;
+    v = (v | (v << 1)) & 0x55555555;
+    return v;
+}
+
+uint32_t ParticleReorder::mortonKey(const Vector2& position, float cellSize) {
+    float cx = std::max(0.0f, std::min(position.x / cellSize, 65535.0f));
+    float cy = std::max(0.0f, std::min(position.y / cellSize, 65535.0f));
+    return spreadBits(static_cast<uint32_t>(cx)) | (spreadBits(static_cast<uint32_t>(cy)) << 1);
+}
+
+void ParticleReorder::radixSort(ThreadPool& pool) {
+    size_t n = keys.size();
+    size_t chunks = (n + chunkSize - 1) / chunkSize;
+    keysScratch.resize(n);
+    orderScratch.resize(n);
+    histograms.resize(chunks * radixBuckets);
+    
+    for (int shift = 0; shift < 32; shift += radixBits) {
+        pool.run(chunks, [&](size_t chunk) {
+            uint32_t* histogram = histograms.data() + chunk * radixBuckets;
+            std::fill(histogram, histogram + radixBuckets, 0);
+            size_t end = std::min((chunk + 1) * chunkSize, n);
+            for (size_t i = chunk * chunkSize; i < end; i++) {
+                histogram[(keys[i] >> shift) & (radixBuckets - 1)]++;
+            }
+        });
+        
+        uint32_t offset = 0;
+        for (int digit = 0; digit < radixBuckets; digit++) {
+            for (size_t chunk = 0; chunk < chunks; chunk++) {
+                uint32_t count = histograms[chunk * radixBuckets + digit];
+                histograms[chunk * radixBuckets + digit] = offset;
+                offset += count;
+            }
+        }
+        
+        pool.run(chunks, [&](size_t chunk) {
+            uint32_t* cursor = histograms.data() + chunk * radixBuckets;
+            size_t end = std::min((chunk + 1) * chunkSize, n);
+            for (size_t i = chunk * chunkSize; i < end; i++) {
+                uint32_t slot = cursor[(keys[i] >> shift) & (radixBuckets - 1)]++;
+                keysScratch[slot] = keys[i];
+                orderScratch[slot] = order[i];
+            }
+        });
+        
+        keys.swap(keysScratch);
+        order.swap(orderScratch);
+    }
+}
+
+ParticleRemap ParticleReorder::reorder(std::vector<Particle>& particles, float cellSize, ThreadPool& pool) {
+    size_t n = particles.size();
+    keys.resize(n);
+    order.resize(n);
+    newIndex.resize(n);
+    
+    pool.parallelFor(n, chunkSize, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            keys[i] = mortonKey(particles[i].position, cellSize);
+            order[i] = static_cast<uint32_t>(i);
+        }
+    });
+    
+    radixSort(pool);
+    
+    scratch.resize(n);
+    pool.parallelFor(n, chunkSize, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            scratch[i] = particles[order[i]];
+            newIndex[order[i]] = static_cast<uint32_t>(i);
+        }
+    });
+    
+    const Particle* oldBase = particles.data();
+    particles.swap(scratch);
+    
+    return { oldBase, particles.data(), newIndex.data() };
+}
\ No newline at end of file
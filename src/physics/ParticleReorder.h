@@ -0,0 +1,27 @@
+#pragma once
+#include "Particle.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <vector>
+
+class ParticleReorder {
+private:
+    std::vector<uint32_t> keys;
+    std::vector<uint32_t> keysScratch;
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> orderScratch;
+    std::vector<uint32_t> newIndex;
+    std::vector<uint32_t> histograms;
+    std::vector<Particle> scratch;
+    
+    static uint32_t spreadBits(uint32_t v);
+    void radixSort(ThreadPool& pool);
+    
+public:
+    static uint32_t mortonKey(const Vector2& position, float cellSize);
+    
+    ParticleRemap reorder(std::vector<Particle>& particles, float cellSize, ThreadPool& pool);
+    
+    const std::vector<uint32_t>& getNewIndex() const { return newIndex; }
+    const std::vector<uint32_t>& getOrder() const { return order; }
+};
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include "QuantizedParticles.h"
+#include <algorithm>
+#include <cmath>
+
+static const float quantizedRange = 32767.0f;
+static const size_t encodeGrain = 8192;
+
+static int16_t quantize(float value) {
+    value = std::max(-quantizedRange, std::min(value, quantizedRange));
+    return static_cast<int16_t>(std::lrint(value));
+}
+
+QuantizedParticles::QuantizedParticles()
+    : origin(0, 0), positionStep(1, 1), velocityStep(1.0f) {}
+
+void QuantizedParticles::encode(const std::vector<Particle>& particles, const Vector2& boundsMin,
+                                const Vector2& boundsMax, float maxSpeed, ThreadPool& pool) {
+    origin = (boundsMin + boundsMax) * 0.5f;
+    positionStep.x = std::max((boundsMax.x - boundsMin.x) * 0.5f, 1e-6f) / quantizedRange;
+    positionStep.y = std::max((boundsMax.y - boundsMin.y) * 0.5f, 1e-6f) / quantizedRange;
+    velocityStep = std::max(maxSpeed, 1e-6f) / quantizedRange;
+    
+    float invX = 1.0f / positionStep.x;
+    float invY = 1.0f / positionStep.y;
+    float invV = 1.0f / velocityStep;
+    
+    data.resize(particles.size());
+    pool.parallelFor(particles.size(), encodeGrain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const Particle& p = particles[i];
+            QuantizedParticle& q = data[i];
+            q.x = quantize((p.position.x - origin.x) * invX);
+            q.y = quantize((p.position.y - origin.y) * invY);
+            q.vx = quantize(p.velocity.x * invV);
+            q.vy = quantize(p.velocity.y * invV);
+        }
+    });
+}
+
+Vector2 QuantizedParticles::decodePosition(size_t i) const {
+    return Vector2(origin.x + data[i].x * positionStep.x, origin.y + data[i].y * positionStep.y);
+}
+
+Vector2 QuantizedParticles::decodeVelocity(size_t i) const {
+    return Vector2(data[i].vx * velocityStep, data[i].vy * velocityStep);
+}
\ No newline at end of file
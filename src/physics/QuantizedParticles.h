@@ -0,0 +1,34 @@
+#pragma once
+#include "Particle.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <vector>
+
+struct QuantizedParticle {
+    int16_t x, y;
+    int16_t vx, vy;
+};
+
+class QuantizedParticles {
+private:
+    std::vector<QuantizedParticle> data;
+    Vector2 origin;
+    Vector2 positionStep;
+    float velocityStep;
+    
+public:
+    QuantizedParticles();
+    
+    void encode(const std::vector<Particle>& particles, const Vector2& boundsMin, const Vector2& boundsMax,
+                float maxSpeed, ThreadPool& pool);
+    
+    Vector2 decodePosition(size_t i) const;
+    Vector2 decodeVelocity(size_t i) const;
+    
+    const QuantizedParticle* getData() const { return data.data(); }
+    size_t size() const { return data.size(); }
+    size_t getByteSize() const { return data.size() * sizeof(QuantizedParticle); }
+    const Vector2& getOrigin() const { return origin; }
+    const Vector2& getPositionStep() const { return positionStep; }
+    float getVelocityStep() const { return velocityStep; }
+};
\ No newline at end of file
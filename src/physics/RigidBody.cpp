@@ -73,39 +73,7 @@ void RigidBody::clearForces() {
 }
 
 void RigidBody::integrate(float dt) {
-    if (hasInfiniteMass()) return;
-    
-    acceleration = forceAccumulator * inverseMass;
-    velocity += acceleration * dt;
-    
-    velocity *= 0.995f;
-    
-    if (velocity.magnitudeSquared() < 0.01f) {
-        velocity.x = 0;
-        velocity.y = 0;
-    }
-    
-    position += velocity * dt;
-    
-    if (!hasInfiniteInertia()) {
-        angularAcceleration = torqueAccumulator * inverseInertia;
-        angularVelocity += angularAcceleration * dt;
-        
-        angularVelocity *= 0.95f;
-        
-        if (std::abs(angularVelocity) < 0.05f) {
-            angularVelocity = 0.0f;
-        }
-        
-        float maxAngularVelocity = 15.0f;
-        if (std::abs(angularVelocity) > maxAngularVelocity) {
-            angularVelocity = angularVelocity > 0 ? maxAngularVelocity : -maxAngularVelocity;
-        }
-        
-        orientation += angularVelocity * dt;
-    }
-    
-    clearForces();
+    integrateWith<Damped<SymplecticEuler, 995, 950>>(dt);
 }
 
 std::vector<Vector2> RigidBody::getVertices() const {
@@ -1,5 +1,8 @@
 #pragma once
 #include "Vector2.h"
+#include "Integrators.h"
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 enum class ShapeType {
@@ -7,6 +10,16 @@ enum class ShapeType {
     BOX
 };
 
+struct RigidBodyMaterial {
+    ShapeType shapeType;
+    float radius;
+    float width, height;
+    float mass;
+    float inertia;
+    float restitution;
+    float friction;
+};
+
 class RigidBody {
 public:
     Vector2 position;
@@ -41,6 +54,37 @@ public:
     void clearForces();
     void integrate(float dt);
     
+    template <typename Integrator>
+    void integrateWith(float dt) {
+        if (hasInfiniteMass()) return;
+        
+        acceleration = forceAccumulator * inverseMass;
+        UniformField field(acceleration.x, acceleration.y);
+        Integrator::step(position.x, position.y, velocity.x, velocity.y, field, dt);
+        
+        if (velocity.magnitudeSquared() < 0.01f) {
+            velocity.x = 0;
+            velocity.y = 0;
+        }
+        
+        if (!hasInfiniteInertia()) {
+            angularAcceleration = torqueAccumulator * inverseInertia;
+            angularVelocity += angularAcceleration * dt;
+            angularVelocity *= IntegratorTraits<Integrator>::angularRetain(1);
+            
+            if (std::abs(angularVelocity) < 0.05f) {
+                angularVelocity = 0.0f;
+            }
+            
+            float maxAngularVelocity = 15.0f;
+            angularVelocity = std::max(-maxAngularVelocity, std::min(angularVelocity, maxAngularVelocity));
+            
+            orientation += angularVelocity * dt;
+        }
+        
+        clearForces();
+    }
+    
     bool hasInfiniteMass() const { return mass <= 0.0f; }
     bool hasInfiniteInertia() const { return inertia <= 0.0f; }
     
@@ -2,19 +2,20 @@
 #include <algorithm>
 #include <cmath>
 
-void RigidBodyResolver::resolveVelocity(RigidContact& contact) {
-    Vector2 r1 = contact.contactPoint - contact.bodyA->position;
-    Vector2 r2 = contact.contactPoint - contact.bodyB->position;
+void RigidBodyResolver::resolveVelocity(RigidBodyRef& bodyA, RigidBodyRef& bodyB,
+                                        const Vector2& contactPoint, const Vector2& normal) {
+    Vector2 r1 = contactPoint - *bodyA.position;
+    Vector2 r2 = contactPoint - *bodyB.position;
     
-    Vector2 v1 = contact.bodyA->velocity + Vector2(-r1.y, r1.x) * contact.bodyA->angularVelocity;
-    Vector2 v2 = contact.bodyB->velocity + Vector2(-r2.y, r2.x) * contact.bodyB->angularVelocity;
+    Vector2 v1 = *bodyA.velocity + Vector2(-r1.y, r1.x) * (*bodyA.angularVelocity);
+    Vector2 v2 = *bodyB.velocity + Vector2(-r2.y, r2.x) * (*bodyB.angularVelocity);
     
     Vector2 relativeVelocity = v2 - v1;
-    float separatingVelocity = relativeVelocity.dot(contact.normal);
+    float separatingVelocity = relativeVelocity.dot(normal);
     
     if (separatingVelocity > 0) return;
     
-    float restitution = std::min(contact.bodyA->restitution, contact.bodyB->restitution);
+    float restitution = std::min(bodyA.restitution, bodyB.restitution);
     
     const float restingThreshold = 1.0f;
     if (std::abs(separatingVelocity) < restingThreshold) {
@@ -23,18 +24,18 @@ void RigidBodyResolver::resolveVelocity(RigidContact& contact) {
     
     float numerator = -(1.0f + restitution) * separatingVelocity;
     
-    float linearTerm = contact.bodyA->inverseMass + contact.bodyB->inverseMass;
+    float linearTerm = bodyA.inverseMass + bodyB.inverseMass;
     
     float angularTerm1 = 0.0f;
-    if (!contact.bodyA->hasInfiniteInertia()) {
-        float r1CrossN = r1.cross(contact.normal);
-        angularTerm1 = (r1CrossN * r1CrossN) * contact.bodyA->inverseInertia;
+    if (!bodyA.hasInfiniteInertia()) {
+        float r1CrossN = r1.cross(normal);
+        angularTerm1 = (r1CrossN * r1CrossN) * bodyA.inverseInertia;
     }
     
     float angularTerm2 = 0.0f;
-    if (!contact.bodyB->hasInfiniteInertia()) {
-        float r2CrossN = r2.cross(contact.normal);
-        angularTerm2 = (r2CrossN * r2CrossN) * contact.bodyB->inverseInertia;
+    if (!bodyB.hasInfiniteInertia()) {
+        float r2CrossN = r2.cross(normal);
+        angularTerm2 = (r2CrossN * r2CrossN) * bodyB.inverseInertia;
     }
     
     float denominator = linearTerm + angularTerm1 + angularTerm2;
@@ -46,40 +47,40 @@ void RigidBodyResolver::resolveVelocity(RigidContact& contact) {
     const float maxImpulse = 1000.0f;
     impulse = std::max(-maxImpulse, std::min(impulse, maxImpulse));
     
-    Vector2 impulseVector = contact.normal * impulse;
+    Vector2 impulseVector = normal * impulse;
     
-    if (!contact.bodyA->hasInfiniteMass()) {
-        contact.bodyA->velocity -= impulseVector * contact.bodyA->inverseMass;
+    if (!bodyA.hasInfiniteMass()) {
+        *bodyA.velocity -= impulseVector * bodyA.inverseMass;
     }
     
-    if (!contact.bodyB->hasInfiniteMass()) {
-        contact.bodyB->velocity += impulseVector * contact.bodyB->inverseMass;
+    if (!bodyB.hasInfiniteMass()) {
+        *bodyB.velocity += impulseVector * bodyB.inverseMass;
     }
     
-    if (!contact.bodyA->hasInfiniteInertia()) {
+    if (!bodyA.hasInfiniteInertia()) {
         float torqueA = r1.cross(impulseVector);
-        float angularImpulseA = torqueA * contact.bodyA->inverseInertia;
+        float angularImpulseA = torqueA * bodyA.inverseInertia;
         
         const float maxAngularImpulse = 10.0f;
         angularImpulseA = std::max(-maxAngularImpulse, std::min(angularImpulseA, maxAngularImpulse));
         
-        contact.bodyA->angularVelocity -= angularImpulseA;
+        *bodyA.angularVelocity -= angularImpulseA;
     }
     
-    if (!contact.bodyB->hasInfiniteInertia()) {
+    if (!bodyB.hasInfiniteInertia()) {
         float torqueB = r2.cross(impulseVector);
-        float angularImpulseB = torqueB * contact.bodyB->inverseInertia;
+        float angularImpulseB = torqueB * bodyB.inverseInertia;
         
         const float maxAngularImpulse = 10.0f;
         angularImpulseB = std::max(-maxAngularImpulse, std::min(angularImpulseB, maxAngularImpulse));
         
-        contact.bodyB->angularVelocity += angularImpulseB;
+        *bodyB.angularVelocity += angularImpulseB;
     }
     
-    Vector2 tangent(-contact.normal.y, contact.normal.x);
+    Vector2 tangent(-normal.y, normal.x);
     
-    v1 = contact.bodyA->velocity + Vector2(-r1.y, r1.x) * contact.bodyA->angularVelocity;
-    v2 = contact.bodyB->velocity + Vector2(-r2.y, r2.x) * contact.bodyB->angularVelocity;
+    v1 = *bodyA.velocity + Vector2(-r1.y, r1.x) * (*bodyA.angularVelocity);
+    v2 = *bodyB.velocity + Vector2(-r2.y, r2.x) * (*bodyB.angularVelocity);
     relativeVelocity = v2 - v1;
     
     float tangentVelocity = relativeVelocity.dot(tangent);
@@ -89,62 +90,124 @@ void RigidBodyResolver::resolveVelocity(RigidContact& contact) {
     float frictionNumerator = -tangentVelocity;
     float frictionImpulse = frictionNumerator / denominator;
     
-    float friction = std::sqrt(contact.bodyA->friction * contact.bodyB->friction);
+    float friction = std::sqrt(bodyA.friction * bodyB.friction);
     float maxFriction = friction * std::abs(impulse);
     
     frictionImpulse = std::max(-maxFriction, std::min(frictionImpulse, maxFriction));
     
     Vector2 frictionVector = tangent * frictionImpulse;
     
-    if (!contact.bodyA->hasInfiniteMass()) {
-        contact.bodyA->velocity -= frictionVector * contact.bodyA->inverseMass;
+    if (!bodyA.hasInfiniteMass()) {
+        *bodyA.velocity -= frictionVector * bodyA.inverseMass;
     }
     
-    if (!contact.bodyB->hasInfiniteMass()) {
-        contact.bodyB->velocity += frictionVector * contact.bodyB->inverseMass;
+    if (!bodyB.hasInfiniteMass()) {
+        *bodyB.velocity += frictionVector * bodyB.inverseMass;
     }
     
-    if (!contact.bodyA->hasInfiniteInertia()) {
+    if (!bodyA.hasInfiniteInertia()) {
         float frictionTorqueA = r1.cross(frictionVector);
-        contact.bodyA->angularVelocity -= frictionTorqueA * contact.bodyA->inverseInertia * 0.5f;
+        *bodyA.angularVelocity -= frictionTorqueA * bodyA.inverseInertia * 0.5f;
     }
     
-    if (!contact.bodyB->hasInfiniteInertia()) {
+    if (!bodyB.hasInfiniteInertia()) {
         float frictionTorqueB = r2.cross(frictionVector);
-        contact.bodyB->angularVelocity += frictionTorqueB * contact.bodyB->inverseInertia * 0.5f;
+        *bodyB.angularVelocity += frictionTorqueB * bodyB.inverseInertia * 0.5f;
     }
 }
 
-void RigidBodyResolver::resolveInterpenetration(RigidContact& contact) {
+void RigidBodyResolver::resolveInterpenetration(RigidBodyRef& bodyA, RigidBodyRef& bodyB,
+                                                const Vector2& normal, float penetration) {
     const float slop = 0.01f;
     const float percent = 0.8f;  
     
-    float correctionMagnitude = std::max(contact.penetration - slop, 0.0f) * percent;
+    float correctionMagnitude = std::max(penetration - slop, 0.0f) * percent;
     
     if (correctionMagnitude <= 0.0f) return;
     
-    float totalInverseMass = contact.bodyA->inverseMass + contact.bodyB->inverseMass;
+    float totalInverseMass = bodyA.inverseMass + bodyB.inverseMass;
     
     if (totalInverseMass <= 0.0f) return;
     
-    Vector2 correction = contact.normal * (correctionMagnitude / totalInverseMass);
+    Vector2 correction = normal * (correctionMagnitude / totalInverseMass);
     
-    if (!contact.bodyA->hasInfiniteMass()) {
-        contact.bodyA->position -= correction * contact.bodyA->inverseMass;
+    if (!bodyA.hasInfiniteMass()) {
+        *bodyA.position -= correction * bodyA.inverseMass;
     }
     
-    if (!contact.bodyB->hasInfiniteMass()) {
-        contact.bodyB->position += correction * contact.bodyB->inverseMass;
+    if (!bodyB.hasInfiniteMass()) {
+        *bodyB.position += correction * bodyB.inverseMass;
     }
 }
 
+RigidBodyRef RigidBodyResolver::makeRef(RigidBody& body) {
+    return { &body.position, &body.velocity, &body.angularVelocity,
+             body.hasInfiniteMass() ? 0.0f : body.inverseMass,
+             body.hasInfiniteInertia() ? 0.0f : body.inverseInertia,
+             body.restitution, body.friction };
+}
+
+void RigidBodyResolver::resolve(RigidBodyRef& bodyA, RigidBodyRef& bodyB, const Vector2& contactPoint,
+                                const Vector2& normal, float penetration) {
+    resolveVelocity(bodyA, bodyB, contactPoint, normal);
+    resolveInterpenetration(bodyA, bodyB, normal, penetration);
+}
+
 void RigidBodyResolver::resolveContact(RigidContact& contact) {
-    resolveVelocity(contact);
-    resolveInterpenetration(contact);
+    RigidBodyRef bodyA = makeRef(*contact.bodyA);
+    RigidBodyRef bodyB = makeRef(*contact.bodyB);
+    resolve(bodyA, bodyB, contact.contactPoint, contact.normal, contact.penetration);
 }
 
 void RigidBodyResolver::resolveContacts(std::vector<RigidContact>& contacts) {
     for (auto& contact : contacts) {
         resolveContact(contact);
     }
+}
+
+void RigidBodyResolver::resolveContactsParallel(std::vector<RigidContact>& contacts,
+                                                std::vector<RigidBody>& bodies, ThreadPool& pool) {
+    const size_t minParallelContacts = 64;
+    if (pool.size() == 1 || contacts.size() < minParallelContacts) {
+        resolveContacts(contacts);
+        return;
+    }
+    
+    size_t count = prepareIslands(contacts, bodies);
+    pool.run(count, [&](size_t i) {
+        resolveIslands(contacts, i, i + 1);
+    });
+}
+
+size_t RigidBodyResolver::prepareIslands(const std::vector<RigidContact>& contacts,
+                                         const std::vector<RigidBody>& bodies) {
+    const RigidBody* base = bodies.data();
+    contactBodies.resize(contacts.size());
+    for (size_t i = 0; i < contacts.size(); i++) {
+        contactBodies[i].a = static_cast<uint32_t>(contacts[i].bodyA - base);
+        contactBodies[i].b = static_cast<uint32_t>(contacts[i].bodyB - base);
+    }
+    
+    isStatic.resize(bodies.size());
+    for (size_t i = 0; i < bodies.size(); i++) {
+        const RigidBody& body = bodies[i];
+        bool fixed = body.hasInfiniteMass() || body.inverseMass == 0.0f;
+        bool unrotatable = body.hasInfiniteInertia() || body.inverseInertia == 0.0f;
+        isStatic[i] = fixed && unrotatable ? 1 : 0;
+    }
+    
+    islands.build(bodies.size(), contactBodies, isStatic);
+    return islands.getIslandCount();
+}
+
+void RigidBodyResolver::resolveIslands(std::vector<RigidContact>& contacts, size_t begin, size_t end) {
+    const std::vector<uint32_t>& order = islands.getIslandsBySize();
+    for (size_t i = begin; i < end; i++) {
+        uint32_t island = order[i];
+        const uint32_t* indices = islands.getIslandContacts(island);
+        size_t count = islands.getIslandSize(island);
+        for (size_t k = 0; k < count; k++) {
+            resolveContact(contacts[indices[k]]);
+        }
+    }
 }
\ No newline at end of file
@@ -1,14 +1,46 @@
 #pragma once
 #include "RigidBody.h"
 #include "Collision.h"
+#include "ContactIslands.h"
+#include "ThreadPool.h"
 #include <vector>
 
+struct RigidBodyRef {
+    Vector2* position;
+    Vector2* velocity;
+    float* angularVelocity;
+    float inverseMass;
+    float inverseInertia;
+    float restitution;
+    float friction;
+    
+    bool hasInfiniteMass() const { return inverseMass == 0.0f; }
+    bool hasInfiniteInertia() const { return inverseInertia == 0.0f; }
+};
+
 class RigidBodyResolver {
+private:
+    ContactIslands islands;
+    std::vector<BodyPair> contactBodies;
+    std::vector<uint8_t> isStatic;
+    
 public:
+    static RigidBodyRef makeRef(RigidBody& body);
+    static void resolve(RigidBodyRef& bodyA, RigidBodyRef& bodyB, const Vector2& contactPoint,
+                        const Vector2& normal, float penetration);
+    
     void resolveContact(RigidContact& contact);
     void resolveContacts(std::vector<RigidContact>& contacts);
+    void resolveContactsParallel(std::vector<RigidContact>& contacts,
+                                 std::vector<RigidBody>& bodies, ThreadPool& pool);
+    size_t prepareIslands(const std::vector<RigidContact>& contacts, const std::vector<RigidBody>& bodies);
+    void resolveIslands(std::vector<RigidContact>& contacts, size_t begin, size_t end);
+    
+    const ContactIslands& getIslands() const { return islands; }
     
 private:
-    void resolveVelocity(RigidContact& contact);
-    void resolveInterpenetration(RigidContact& contact);
+    static void resolveVelocity(RigidBodyRef& bodyA, RigidBodyRef& bodyB,
+                                const Vector2& contactPoint, const Vector2& normal);
+    static void resolveInterpenetration(RigidBodyRef& bodyA, RigidBodyRef& bodyB,
+                                        const Vector2& normal, float penetration);
 };
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include "RigidNarrowphase.h"
+#include <algorithm>
+#include <cmath>
+
+const RigidNarrowphase::Kernel RigidNarrowphase::kernels[static_cast<int>(ShapePair::COUNT)] = {
+    &RigidNarrowphase::circleCircleKernel,
+    &RigidNarrowphase::circleBoxKernel,
+    &RigidNarrowphase::boxBoxKernel
+};
+
+ShapePair RigidNarrowphase::classify(ShapeType a, ShapeType b) {
+    static constexpr ShapePair table[2][2] = {
+        { ShapePair::CIRCLE_CIRCLE, ShapePair::CIRCLE_BOX },
+        { ShapePair::CIRCLE_BOX, ShapePair::BOX_BOX }
+    };
+    return table[static_cast<int>(a)][static_cast<int>(b)];
+}
+
+void RigidNarrowphase::buildPairs(const std::vector<RigidBody>& bodies) {
+    for (auto& bucket : buckets) {
+        bucket.clear();
+    }
+    
+    sweep.resize(bodies.size());
+    for (size_t i = 0; i < bodies.size(); i++) {
+        const RigidBody& body = bodies[i];
+        float extent = body.shapeType == ShapeType::CIRCLE
+            ? body.radius
+            : std::max(body.width, body.height) * 0.71f;
+        sweep[i] = { body.position.x - extent, body.position.x + extent,
+                     body.position.y - extent, body.position.y + extent,
+                     static_cast<uint32_t>(i) };
+    }
+    
+    std::sort(sweep.begin(), sweep.end(), [](const SweepEntry& a, const SweepEntry& b) {
+        return a.minX < b.minX;
+    });
+    
+    for (size_t i = 0; i < sweep.size(); i++) {
+        const SweepEntry& a = sweep[i];
+        for (size_t j = i + 1; j < sweep.size() && sweep[j].minX <= a.maxX; j++) {
+            const SweepEntry& b = sweep[j];
+            if (a.maxY < b.minY || a.minY > b.maxY) continue;
+            
+            ShapeType typeA = bodies[a.index].shapeType;
+            ShapeType typeB = bodies[b.index].shapeType;
+            ShapePair pair = classify(typeA, typeB);
+            
+            if (pair == ShapePair::CIRCLE_BOX && typeA == ShapeType::BOX) {
+                buckets[static_cast<int>(pair)].push_back({ b.index, a.index });
+            } else {
+                buckets[static_cast<int>(pair)].push_back({ a.index, b.index });
+            }
+        }
+    }
+}
+
+void RigidNarrowphase::circleCircleKernel(RigidNarrowphase& np, std::vector<RigidBody>& bodies,
+                                          const std::vector<BodyPair>& pairs,
+                                          std::vector<RigidContact>& contacts) {
+    size_t count = pairs.size();
+    np.ax.resize(count); np.ay.resize(count); np.ar.resize(count);
+    np.bx.resize(count); np.by.resize(count); np.br.resize(count);
+    np.distSq.resize(count); np.radiusSum.resize(count);
+    
+    for (size_t i = 0; i < count; i++) {
+        const RigidBody& a = bodies[pairs[i].a];
+        const RigidBody& b = bodies[pairs[i].b];
+        np.ax[i] = a.position.x; np.ay[i] = a.position.y; np.ar[i] = a.radius;
+        np.bx[i] = b.position.x; np.by[i] = b.position.y; np.br[i] = b.radius;
+    }
+    
+    const float* __restrict pax = np.ax.data();
+    const float* __restrict pay = np.ay.data();
+    const float* __restrict par = np.ar.data();
+    const float* __restrict pbx = np.bx.data();
+    const float* __restrict pby = np.by.data();
+    const float* __restrict pbr = np.br.data();
+    float* __restrict pd = np.distSq.data();
+    float* __restrict prs = np.radiusSum.data();
+    
+    for (size_t i = 0; i < count; i++) {
+        float dx = pbx[i] - pax[i];
+        float dy = pby[i] - pay[i];
+        pd[i] = dx * dx + dy * dy;
+        prs[i] = par[i] + pbr[i];
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        if (pd[i] >= prs[i] * prs[i]) continue;
+        
+        RigidBody& a = bodies[pairs[i].a];
+        RigidBody& b = bodies[pairs[i].b];
+        
+        float distance = std::sqrt(pd[i]);
+        Vector2 normal;
+        if (distance > 0.001f) {
+            normal = (b.position - a.position) / distance;
+        } else {
+            normal = Vector2(0, -1);
+        }
+        
+        Vector2 contactPoint = a.position + normal * a.radius;
+        contacts.emplace_back(&a, &b, contactPoint, normal, prs[i] - distance);
+    }
+}
+
+void RigidNarrowphase::circleBoxKernel(RigidNarrowphase&, std::vector<RigidBody>& bodies,
+                                       const std::vector<BodyPair>& pairs,
+                                       std::vector<RigidContact>& contacts) {
+    for (const auto& pair : pairs) {
+        RigidContact* contact = CollisionDetector::generateCircleBoxContact(bodies[pair.a], bodies[pair.b]);
+        if (contact) {
+            contacts.push_back(*contact);
+            delete contact;
+        }
+    }
+}
+
+void RigidNarrowphase::boxBoxKernel(RigidNarrowphase&, std::vector<RigidBody>& bodies,
+                                    const std::vector<BodyPair>& pairs,
+                                    std::vector<RigidContact>& contacts) {
+    for (const auto& pair : pairs) {
+        RigidContact* contact = CollisionDetector::generateBoxBoxContact(bodies[pair.a], bodies[pair.b]);
+        if (contact) {
+            contacts.push_back(*contact);
+            delete contact;
+        }
+    }
+}
+
+void RigidNarrowphase::generateContacts(std::vector<RigidBody>& bodies, std::vector<RigidContact>& contacts) {
+    for (int i = 0; i < static_cast<int>(ShapePair::COUNT); i++) {
+        if (buckets[i].empty()) continue;
+        kernels[i](*this, bodies, buckets[i], contacts);
+    }
+}
+
+void RigidNarrowphase::detect(std::vector<RigidBody>& bodies, std::vector<RigidContact>& contacts) {
+    buildPairs(bodies);
+    generateContacts(bodies, contacts);
+}
\ No newline at end of file
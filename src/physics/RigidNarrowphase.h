@@ -0,0 +1,49 @@
+#pragma once
+#include "RigidBody.h"
+#include "Collision.h"
+#include <cstdint>
+#include <vector>
+
+enum class ShapePair {
+    CIRCLE_CIRCLE,
+    CIRCLE_BOX,
+    BOX_BOX,
+    COUNT
+};
+
+class RigidNarrowphase {
+private:
+    struct SweepEntry {
+        float minX;
+        float maxX;
+        float minY;
+        float maxY;
+        uint32_t index;
+    };
+    
+    std::vector<SweepEntry> sweep;
+    std::vector<BodyPair> buckets[static_cast<int>(ShapePair::COUNT)];
+    
+    std::vector<float> ax, ay, ar, bx, by, br;
+    std::vector<float> distSq, radiusSum;
+    
+    using Kernel = void (*)(RigidNarrowphase&, std::vector<RigidBody>&,
+                            const std::vector<BodyPair>&, std::vector<RigidContact>&);
+    static const Kernel kernels[static_cast<int>(ShapePair::COUNT)];
+    
+    static void circleCircleKernel(RigidNarrowphase& np, std::vector<RigidBody>& bodies,
+                                   const std::vector<BodyPair>& pairs, std::vector<RigidContact>& contacts);
+    static void circleBoxKernel(RigidNarrowphase& np, std::vector<RigidBody>& bodies,
+                                const std::vector<BodyPair>& pairs, std::vector<RigidContact>& contacts);
+    static void boxBoxKernel(RigidNarrowphase& np, std::vector<RigidBody>& bodies,
+                             const std::vector<BodyPair>& pairs, std::vector<RigidContact>& contacts);
+    
+public:
+    void buildPairs(const std::vector<RigidBody>& bodies);
+    void generateContacts(std::vector<RigidBody>& bodies, std::vector<RigidContact>& contacts);
+    void detect(std::vector<RigidBody>& bodies, std::vector<RigidContact>& contacts);
+    
+    const std::vector<BodyPair>& getPairs(ShapePair pair) const { return buckets[static_cast<int>(pair)]; }
+    
+    static ShapePair classify(ShapeType a, ShapeType b);
+};
\ No newline at end of file
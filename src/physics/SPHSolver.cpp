@@ -0,0 +1,209 @@
+#include "SPHSolver.h"
+#include <algorithm>
+#include <cmath>
+
+SPHSolver::SPHSolver(int worldWidth, int worldHeight, const SPHParameters& p)
+    : params(p), worldWidth(worldWidth), worldHeight(worldHeight) {
+    rebuildGrid();
+    updateCoefficients();
+}
+
+void SPHSolver::setParameters(const SPHParameters& p) {
+    params = p;
+    rebuildGrid();
+    updateCoefficients();
+}
+
+void SPHSolver::rebuildGrid() {
+    int cellSize = std::max(1, static_cast<int>(std::ceil(params.smoothingRadius)));
+    grid = std::make_unique<SpatialGrid>(worldWidth, worldHeight, cellSize);
+}
+
+void SPHSolver::updateCoefficients() {
+    float h = params.smoothingRadius;
+    float pi = static_cast<float>(M_PI);
+    poly6Coefficient = 4.0f / (pi * std::pow(h, 8.0f));
+    spikyGradCoefficient = -30.0f / (pi * std::pow(h, 5.0f));
+    viscosityLapCoefficient = 40.0f / (pi * std::pow(h, 5.0f));
+    cohesionCoefficient = 32.0f / (pi * std::pow(h, 9.0f));
+}
+
+size_t SPHSolver::beginStep(const std::vector<Particle>& particles) {
+    size_t n = particles.size();
+    posX.resize(n); posY.resize(n);
+    velX.resize(n); velY.resize(n);
+    mass.resize(n);
+    density.resize(n); pressure.resize(n);
+    return n;
+}
+
+void SPHSolver::gatherState(const std::vector<Particle>& particles, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        const Particle& p = particles[i];
+        posX[i] = p.position.x;
+        posY[i] = p.position.y;
+        velX[i] = p.velocity.x;
+        velY[i] = p.velocity.y;
+        mass[i] = p.hasInfiniteMass() ? 0.0f : p.getMass();
+    }
+}
+
+size_t SPHSolver::beginNeighborSearch(std::vector<Particle>& particles) {
+    size_t n = particles.size();
+    
+    grid->clear();
+    for (auto& particle : particles) {
+        if (!particle.hasInfiniteMass()) {
+            grid->insert(particle);
+        }
+    }
+    
+    size_t chunks = (n + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunkNeighbors.resize(chunks);
+    neighborStart.assign(n + 1, 0);
+    return chunks;
+}
+
+void SPHSolver::findNeighbors(std::vector<Particle>& particles, size_t chunkBegin, size_t chunkEnd) {
+    size_t n = particles.size();
+    float h2 = params.smoothingRadius * params.smoothingRadius;
+    const Particle* base = particles.data();
+    std::vector<Particle*> nearby;
+    
+    for (size_t chunk = chunkBegin; chunk < chunkEnd; chunk++) {
+        std::vector<uint32_t>& list = chunkNeighbors[chunk];
+        list.clear();
+        
+        size_t begin = chunk * CHUNK_SIZE;
+        size_t end = std::min(begin + CHUNK_SIZE, n);
+        for (size_t i = begin; i < end; i++) {
+            if (mass[i] == 0.0f) continue;
+            
+            grid->query(particles[i], nearby);
+            uint32_t count = 0;
+            for (Particle* other : nearby) {
+                uint32_t j = static_cast<uint32_t>(other - base);
+                float dx = posX[j] - posX[i];
+                float dy = posY[j] - posY[i];
+                if (dx * dx + dy * dy < h2) {
+                    list.push_back(j);
+                    count++;
+                }
+            }
+            neighborStart[i + 1] = count;
+        }
+    }
+}
+
+size_t SPHSolver::finishNeighborSearch() {
+    size_t n = neighborStart.size() - 1;
+    for (size_t i = 0; i < n; i++) {
+        neighborStart[i + 1] += neighborStart[i];
+    }
+    neighborIndex.resize(neighborStart[n]);
+    
+    for (size_t chunk = 0; chunk < chunkNeighbors.size(); chunk++) {
+        const std::vector<uint32_t>& list = chunkNeighbors[chunk];
+        std::copy(list.begin(), list.end(), neighborIndex.begin() + neighborStart[chunk * CHUNK_SIZE]);
+    }
+    return n;
+}
+
+void SPHSolver::computeDensity(size_t begin, size_t end) {
+    float h2 = params.smoothingRadius * params.smoothingRadius;
+    float k = params.stiffness;
+    float rho0 = params.restDensity;
+    
+    const uint32_t* __restrict neighbors = neighborIndex.data();
+    for (size_t i = begin; i < end; i++) {
+        float xi = posX[i];
+        float yi = posY[i];
+        float rho = 0.0f;
+        
+        for (uint32_t s = neighborStart[i]; s < neighborStart[i + 1]; s++) {
+            uint32_t j = neighbors[s];
+            float dx = posX[j] - xi;
+            float dy = posY[j] - yi;
+            float w = std::max(h2 - (dx * dx + dy * dy), 0.0f);
+            rho += mass[j] * w * w * w;
+        }
+        
+        rho *= poly6Coefficient;
+        density[i] = rho;
+        pressure[i] = std::max(k * (rho - rho0), 0.0f);
+    }
+}
+
+void SPHSolver::applyForces(std::vector<Particle>& particles, size_t begin, size_t end) {
+    float h = params.smoothingRadius;
+    float mu = params.viscosity;
+    float gamma = params.surfaceTension;
+    
+    const uint32_t* __restrict neighbors = neighborIndex.data();
+    for (size_t i = begin; i < end; i++) {
+        if (mass[i] == 0.0f || density[i] <= 0.0f) continue;
+        
+        float xi = posX[i], yi = posY[i];
+        float vxi = velX[i], vyi = velY[i];
+        float pi = pressure[i];
+        float fx = 0.0f, fy = 0.0f;
+        float cx = 0.0f, cy = 0.0f;
+        
+        for (uint32_t s = neighborStart[i]; s < neighborStart[i + 1]; s++) {
+            uint32_t j = neighbors[s];
+            if (j == i) continue;
+            
+            float dx = xi - posX[j];
+            float dy = yi - posY[j];
+            float r = std::sqrt(dx * dx + dy * dy);
+            if (r <= 1e-6f || r >= h || density[j] <= 0.0f) continue;
+            
+            float invR = 1.0f / r;
+            float q = h - r;
+            float mj = mass[j];
+            float invRhoJ = 1.0f / density[j];
+            
+            float pressureTerm = -mj * (pi + pressure[j]) * 0.5f * invRhoJ *
+                                 spikyGradCoefficient * q * q * invR;
+            float viscosityTerm = mu * mj * invRhoJ * viscosityLapCoefficient * q;
+            
+            float cohesion;
+            if (2.0f * r > h) {
+                cohesion = q * q * q * r * r * r;
+            } else {
+                cohesion = 2.0f * q * q * q * r * r * r - h * h * h * h * h * h / 64.0f;
+            }
+            float cohesionTerm = -gamma * mass[i] * mj * cohesionCoefficient * cohesion * invR;
+            
+            fx += pressureTerm * dx + viscosityTerm * (velX[j] - vxi);
+            fy += pressureTerm * dy + viscosityTerm * (velY[j] - vyi);
+            cx += cohesionTerm * dx;
+            cy += cohesionTerm * dy;
+        }
+        
+        float volume = mass[i] / density[i];
+        particles[i].addForce(Vector2(fx * volume + cx, fy * volume + cy));
+    }
+}
+
+void SPHSolver::computeForces(std::vector<Particle>& particles, ThreadPool& pool) {
+    if (particles.empty()) return;
+    
+    size_t n = beginStep(particles);
+    pool.parallelFor(n, CHUNK_SIZE, [&](size_t begin, size_t end) {
+        gatherState(particles, begin, end);
+    });
+    
+    size_t chunks = beginNeighborSearch(particles);
+    pool.parallelFor(chunks, 1, [&](size_t begin, size_t end) {
+        findNeighbors(particles, begin, end);
+    });
+    finishNeighborSearch();
+    
+    pool.parallelFor(n, CHUNK_SIZE, [&](size_t begin, size_t end) {
+        computeDensity(begin, end);
+    });
+    pool.parallelFor(n, CHUNK_SIZE, [&](size_t begin, size_t end) {
+        applyForces(particles, begin, end);
+    });
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+#include "Particle.h"
+#include "Collision.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct SPHParameters {
+    float smoothingRadius;
+    float restDensity;
+    float stiffness;
+    float viscosity;
+    float surfaceTension;
+    
+    SPHParameters()
+        : smoothingRadius(16.0f), restDensity(0.015f), stiffness(4.0e5f),
+          viscosity(40.0f), surfaceTension(2.0e4f) {}
+};
+
+class SPHSolver {
+private:
+    SPHParameters params;
+    int worldWidth;
+    int worldHeight;
+    std::unique_ptr<SpatialGrid> grid;
+    
+    std::vector<float> posX, posY, velX, velY, mass;
+    std::vector<float> density, pressure;
+    
+    std::vector<uint32_t> neighborStart;
+    std::vector<uint32_t> neighborIndex;
+    std::vector<std::vector<uint32_t>> chunkNeighbors;
+    
+    float poly6Coefficient;
+    float spikyGradCoefficient;
+    float viscosityLapCoefficient;
+    float cohesionCoefficient;
+    
+    void updateCoefficients();
+    void rebuildGrid();
+    
+public:
+    static const size_t CHUNK_SIZE = 256;
+    
+    SPHSolver(int worldWidth, int worldHeight, const SPHParameters& params = SPHParameters());
+    
+    void computeForces(std::vector<Particle>& particles, ThreadPool& pool);
+    
+    size_t beginStep(const std::vector<Particle>& particles);
+    void gatherState(const std::vector<Particle>& particles, size_t begin, size_t end);
+    size_t beginNeighborSearch(std::vector<Particle>& particles);
+    void findNeighbors(std::vector<Particle>& particles, size_t chunkBegin, size_t chunkEnd);
+    size_t finishNeighborSearch();
+    void computeDensity(size_t begin, size_t end);
+    void applyForces(std::vector<Particle>& particles, size_t begin, size_t end);
+    
+    void setParameters(const SPHParameters& p);
+    const SPHParameters& getParameters() const { return params; }
+    
+    const std::vector<float>& getDensities() const { return density; }
+    size_t getNeighborCount() const { return neighborIndex.size(); }
+};
\ No newline at end of file
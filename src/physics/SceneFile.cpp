@@ -0,0 +1,333 @@
+#include "SceneFile.h"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char sceneMagic[4] = { 'P', 'S', 'C', 'N' };
+static const uint64_t sectionAlignment = 16;
+
+static uint64_t alignSection(uint64_t offset) {
+    return (offset + sectionAlignment - 1) & ~(sectionAlignment - 1);
+}
+
+static bool sectionFits(uint64_t offset, uint64_t count, size_t recordSize, uint64_t fileSize) {
+    if (offset % alignof(float) != 0 || offset > fileSize) return false;
+    return count <= (fileSize - offset) / recordSize;
+}
+
+SceneFile::SceneFile()
+    : mapping(nullptr), mappingSize(0), header(nullptr) {}
+
+SceneFile::~SceneFile() {
+    close();
+}
+
+bool SceneFile::open(const std::string& path, std::string& error) {
+    close();
+    
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + path;
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SceneHeader)) {
+        ::close(fd);
+        error = path + " is too small to be a scene file";
+        return false;
+    }
+    
+    mappingSize = static_cast<size_t>(info.st_size);
+    mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        mappingSize = 0;
+        error = "cannot map " + path;
+        return false;
+    }
+    madvise(mapping, mappingSize, MADV_SEQUENTIAL | MADV_WILLNEED);
+    
+    header = static_cast<const SceneHeader*>(mapping);
+    if (!validate(error)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void SceneFile::close() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    header = nullptr;
+}
+
+bool SceneFile::validate(std::string& error) const {
+    if (std::memcmp(header->magic, sceneMagic, sizeof(sceneMagic)) != 0) {
+        error = "not a scene file";
+        return false;
+    }
+    if (header->version != sceneFileVersion) {
+        error = "unsupported scene version " + std::to_string(header->version);
+        return false;
+    }
+    if (header->fileSize != mappingSize) {
+        error = "scene file is truncated";
+        return false;
+    }
+    if (!sectionFits(header->particleOffset, header->particleCount, sizeof(SceneParticle), mappingSize) ||
+        !sectionFits(header->rigidBodyOffset, header->rigidBodyCount, sizeof(SceneRigidBody), mappingSize) ||
+        !sectionFits(header->constraintOffset, header->constraintCount, sizeof(SceneConstraint), mappingSize) ||
+        !sectionFits(header->forceOffset, header->forceCount, sizeof(SceneForce), mappingSize)) {
+        error = "scene section out of bounds";
+        return false;
+    }
+    
+    const SceneConstraint* constraints = getConstraints();
+    uint32_t particleCount = header->particleCount;
+    for (uint32_t i = 0; i < header->constraintCount; i++) {
+        const SceneConstraint& c = constraints[i];
+        bool valid = c.a < particleCount;
+        switch (c.type) {
+            case SceneConstraintType::DISTANCE:
+            case SceneConstraintType::SPRING:
+                valid = valid && c.b < particleCount;
+                break;
+            case SceneConstraintType::PIN:
+                break;
+            case SceneConstraintType::ANGLE:
+                valid = valid && c.b < particleCount && c.c < particleCount;
+                break;
+            default:
+                valid = false;
+        }
+        if (!valid) {
+            error = "invalid constraint " + std::to_string(i);
+            return false;
+        }
+    }
+    
+    const SceneForce* forces = getForces();
+    for (uint32_t i = 0; i < header->forceCount; i++) {
+        if (static_cast<uint32_t>(forces[i].type) > static_cast<uint32_t>(SceneForceType::FRICTION)) {
+            error = "invalid force generator " + std::to_string(i);
+            return false;
+        }
+    }
+    return true;
+}
+
+const SceneParticle* SceneFile::getParticles() const {
+    return reinterpret_cast<const SceneParticle*>(static_cast<const char*>(mapping) + header->particleOffset);
+}
+
+const SceneRigidBody* SceneFile::getRigidBodies() const {
+    return reinterpret_cast<const SceneRigidBody*>(static_cast<const char*>(mapping) + header->rigidBodyOffset);
+}
+
+const SceneConstraint* SceneFile::getConstraints() const {
+    return reinterpret_cast<const SceneConstraint*>(static_cast<const char*>(mapping) + header->constraintOffset);
+}
+
+const SceneForce* SceneFile::getForces() const {
+    return reinterpret_cast<const SceneForce*>(static_cast<const char*>(mapping) + header->forceOffset);
+}
+
+void SceneFile::loadRigidBodies(std::vector<RigidBody>& bodies) const {
+    const SceneRigidBody* records = getRigidBodies();
+    bodies.clear();
+    bodies.reserve(header->rigidBodyCount);
+    
+    for (uint32_t i = 0; i < header->rigidBodyCount; i++) {
+        const SceneRigidBody& r = records[i];
+        Vector2 position(r.x, r.y);
+        if (r.shape == static_cast<uint32_t>(ShapeType::CIRCLE)) {
+            bodies.push_back(RigidBody::createCircle(position, r.radius, r.mass));
+        } else {
+            bodies.push_back(RigidBody::createBox(position, r.width, r.height, r.mass));
+        }
+        
+        RigidBody& body = bodies.back();
+        body.velocity = Vector2(r.vx, r.vy);
+        body.orientation = r.orientation;
+        body.angularVelocity = r.angularVelocity;
+        body.restitution = r.restitution;
+        body.friction = r.friction;
+    }
+}
+
+bool SceneFile::write(const std::string& path, const SceneData& scene, std::string& error) {
+    SceneHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, sceneMagic, sizeof(sceneMagic));
+    h.version = sceneFileVersion;
+    h.worldWidth = scene.worldWidth;
+    h.worldHeight = scene.worldHeight;
+    h.particleCount = static_cast<uint32_t>(scene.particles.size());
+    h.rigidBodyCount = static_cast<uint32_t>(scene.rigidBodies.size());
+    h.constraintCount = static_cast<uint32_t>(scene.constraints.size());
+    h.forceCount = static_cast<uint32_t>(scene.forces.size());
+    
+    h.particleOffset = alignSection(sizeof(SceneHeader));
+    h.rigidBodyOffset = alignSection(h.particleOffset + h.particleCount * sizeof(SceneParticle));
+    h.constraintOffset = alignSection(h.rigidBodyOffset + h.rigidBodyCount * sizeof(SceneRigidBody));
+    h.forceOffset = alignSection(h.constraintOffset + h.constraintCount * sizeof(SceneConstraint));
+    h.fileSize = h.forceOffset + h.forceCount * sizeof(SceneForce);
+    
+    std::vector<char> buffer(h.fileSize, 0);
+    std::memcpy(buffer.data(), &h, sizeof(h));
+    if (h.particleCount) {
+        std::memcpy(buffer.data() + h.particleOffset, scene.particles.data(),
+                    h.particleCount * sizeof(SceneParticle));
+    }
+    if (h.rigidBodyCount) {
+        std::memcpy(buffer.data() + h.rigidBodyOffset, scene.rigidBodies.data(),
+                    h.rigidBodyCount * sizeof(SceneRigidBody));
+    }
+    if (h.constraintCount) {
+        std::memcpy(buffer.data() + h.constraintOffset, scene.constraints.data(),
+                    h.constraintCount * sizeof(SceneConstraint));
+    }
+    if (h.forceCount) {
+        std::memcpy(buffer.data() + h.forceOffset, scene.forces.data(), h.forceCount * sizeof(SceneForce));
+    }
+    
+    std::ofstream out(path, std::ios::binary);
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!out) {
+        error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+static bool readFloats(std::istringstream& line, float* values, int required, int total) {
+    for (int i = 0; i < total; i++) {
+        if (!(line >> values[i])) {
+            if (i < required) return false;
+            line.clear();
+            break;
+        }
+    }
+    return true;
+}
+
+static float particleDistance(const SceneData& scene, uint32_t a, uint32_t b) {
+    float dx = scene.particles[b].x - scene.particles[a].x;
+    float dy = scene.particles[b].y - scene.particles[a].y;
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+bool SceneFile::parseText(std::istream& in, SceneData& scene, std::string& error) {
+    std::string text;
+    int lineNumber = 0;
+    
+    while (std::getline(in, text)) {
+        lineNumber++;
+        size_t comment = text.find('#');
+        if (comment != std::string::npos) text.erase(comment);
+        
+        std::istringstream line(text);
+        std::string keyword;
+        if (!(line >> keyword)) continue;
+        
+        bool ok = true;
+        uint32_t count = static_cast<uint32_t>(scene.particles.size());
+        
+        if (keyword == "world") {
+            ok = static_cast<bool>(line >> scene.worldWidth >> scene.worldHeight);
+        } else if (keyword == "particle") {
+            float v[6] = { 0, 0, 0, 0, 1.0f, 5.0f };
+            ok = readFloats(line, v, 2, 6);
+            scene.particles.push_back({ v[0], v[1], v[2], v[3], v[4], v[5] });
+        } else if (keyword == "circle" || keyword == "box") {
+            SceneRigidBody body;
+            std::memset(&body, 0, sizeof(body));
+            body.restitution = 0.5f;
+            body.friction = 0.3f;
+            float v[7] = { 0, 0, 0, 0, 0, 0, 0 };
+            if (keyword == "circle") {
+                body.shape = static_cast<uint32_t>(ShapeType::CIRCLE);
+                v[3] = 1.0f;
+                ok = readFloats(line, v, 3, 6);
+                body.radius = v[2];
+                body.mass = v[3];
+                body.vx = v[4];
+                body.vy = v[5];
+            } else {
+                body.shape = static_cast<uint32_t>(ShapeType::BOX);
+                v[4] = 1.0f;
+                ok = readFloats(line, v, 4, 7);
+                body.width = v[2];
+                body.height = v[3];
+                body.mass = v[4];
+                body.vx = v[5];
+                body.vy = v[6];
+            }
+            body.x = v[0];
+            body.y = v[1];
+            scene.rigidBodies.push_back(body);
+        } else if (keyword == "distance" || keyword == "spring") {
+            SceneConstraint c = { SceneConstraintType::DISTANCE, 0, 0, 0, { -1.0f, 1.0f, 0.1f } };
+            ok = static_cast<bool>(line >> c.a >> c.b) && c.a < count && c.b < count;
+            if (keyword == "spring") {
+                c.type = SceneConstraintType::SPRING;
+                c.params[1] = 50.0f;
+            }
+            ok = ok && readFloats(line, c.params, 0, 3);
+            if (ok && c.params[0] < 0.0f) c.params[0] = particleDistance(scene, c.a, c.b);
+            scene.constraints.push_back(c);
+        } else if (keyword == "pin") {
+            SceneConstraint c = { SceneConstraintType::PIN, 0, 0, 0, { 0.0f, 0.0f, 1.0f } };
+            ok = static_cast<bool>(line >> c.a) && c.a < count;
+            if (ok) {
+                c.params[0] = scene.particles[c.a].x;
+                c.params[1] = scene.particles[c.a].y;
+                ok = readFloats(line, c.params, 0, 3);
+            }
+            scene.constraints.push_back(c);
+        } else if (keyword == "angle") {
+            SceneConstraint c = { SceneConstraintType::ANGLE, 0, 0, 0, { 0.0f, 0.5f, 0.0f } };
+            ok = static_cast<bool>(line >> c.a >> c.b >> c.c) && c.a < count && c.b < count && c.c < count;
+            ok = ok && readFloats(line, c.params, 1, 2);
+            scene.constraints.push_back(c);
+        } else {
+            SceneForce f = { SceneForceType::GRAVITY, { 0, 0, 0, 0 } };
+            if (keyword == "gravity") {
+                ok = readFloats(line, f.params, 2, 2);
+            } else if (keyword == "drag") {
+                f.type = SceneForceType::DRAG;
+                ok = readFloats(line, f.params, 2, 2);
+            } else if (keyword == "wind") {
+                f.type = SceneForceType::WIND;
+                ok = readFloats(line, f.params, 3, 3);
+            } else if (keyword == "attractor") {
+                f.type = SceneForceType::ATTRACTOR;
+                f.params[3] = 10.0f;
+                ok = readFloats(line, f.params, 3, 4);
+            } else if (keyword == "friction") {
+                f.type = SceneForceType::FRICTION;
+                ok = readFloats(line, f.params, 1, 1);
+            } else {
+                error = "line " + std::to_string(lineNumber) + ": unknown keyword '" + keyword + "'";
+                return false;
+            }
+            scene.forces.push_back(f);
+        }
+        
+        if (!ok) {
+            error = "line " + std::to_string(lineNumber) + ": malformed '" + keyword + "'";
+            return false;
+        }
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+#pragma once
+#include "Particle.h"
+#include "RigidBody.h"
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+static const uint32_t sceneFileVersion = 1;
+
+enum class SceneConstraintType : uint32_t {
+    DISTANCE,
+    SPRING,
+    PIN,
+    ANGLE
+};
+
+enum class SceneForceType : uint32_t {
+    GRAVITY,
+    DRAG,
+    WIND,
+    ATTRACTOR,
+    FRICTION
+};
+
+struct SceneHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t worldWidth;
+    uint32_t worldHeight;
+    uint32_t particleCount;
+    uint32_t rigidBodyCount;
+    uint32_t constraintCount;
+    uint32_t forceCount;
+    uint64_t particleOffset;
+    uint64_t rigidBodyOffset;
+    uint64_t constraintOffset;
+    uint64_t forceOffset;
+    uint64_t fileSize;
+};
+
+struct SceneParticle {
+    float x, y;
+    float vx, vy;
+    float mass;
+    float radius;
+};
+
+struct SceneRigidBody {
+    uint32_t shape;
+    float x, y;
+    float vx, vy;
+    float orientation;
+    float angularVelocity;
+    float mass;
+    float restitution;
+    float friction;
+    float radius;
+    float width, height;
+};
+
+struct SceneConstraint {
+    SceneConstraintType type;
+    uint32_t a, b, c;
+    float params[3];
+};
+
+struct SceneForce {
+    SceneForceType type;
+    float params[4];
+};
+
+struct SceneData {
+    uint32_t worldWidth = 800;
+    uint32_t worldHeight = 600;
+    std::vector<SceneParticle> particles;
+    std::vector<SceneRigidBody> rigidBodies;
+    std::vector<SceneConstraint> constraints;
+    std::vector<SceneForce> forces;
+};
+
+class SceneFile {
+private:
+    void* mapping;
+    size_t mappingSize;
+    const SceneHeader* header;
+    
+    bool validate(std::string& error) const;
+    
+public:
+    SceneFile();
+    ~SceneFile();
+    SceneFile(const SceneFile&) = delete;
+    SceneFile& operator=(const SceneFile&) = delete;
+    
+    bool open(const std::string& path, std::string& error);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+    
+    const SceneHeader& getHeader() const { return *header; }
+    const SceneParticle* getParticles() const;
+    const SceneRigidBody* getRigidBodies() const;
+    const SceneConstraint* getConstraints() const;
+    const SceneForce* getForces() const;
+    
+    void loadRigidBodies(std::vector<RigidBody>& bodies) const;
+    
+    static bool write(const std::string& path, const SceneData& scene, std::string& error);
+    static bool parseText(std::istream& in, SceneData& scene, std::string& error);
+};
\ No newline at end of file
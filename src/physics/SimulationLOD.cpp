@@ -0,0 +1,57 @@
+#include "SimulationLOD.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+SimulationLOD::SimulationLOD(float fullMargin, float reducedMargin, float hysteresis)
+    : fullMargin(fullMargin), reducedMargin(reducedMargin), hysteresis(hysteresis),
+      reducedInterval(4), dormantInterval(16), reducedIterations(1) {}
+
+void SimulationLOD::addInterestPoint(const Vector2& point, float radius) {
+    regions.push_back({ Vector2(point.x - radius, point.y - radius),
+                        Vector2(point.x + radius, point.y + radius) });
+}
+
+bool SimulationLOD::covers(const Vector2& min, const Vector2& max, float margin) const {
+    for (const auto& region : regions) {
+        if (region.min.x - margin <= min.x && region.min.y - margin <= min.y &&
+            region.max.x + margin >= max.x && region.max.y + margin >= max.y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+float SimulationLOD::distanceToInterest(const Vector2& position) const {
+    float best = std::numeric_limits<float>::max();
+    for (const auto& region : regions) {
+        float dx = std::max(0.0f, std::max(region.min.x - position.x, position.x - region.max.x));
+        float dy = std::max(0.0f, std::max(region.min.y - position.y, position.y - region.max.y));
+        best = std::min(best, dx * dx + dy * dy);
+    }
+    return std::sqrt(best);
+}
+
+DetailTier SimulationLOD::classify(const Vector2& position, float extent, DetailTier previous) const {
+    if (regions.empty()) return DetailTier::FULL;
+    
+    float distance = distanceToInterest(position) - extent;
+    float fullLimit = fullMargin + (previous == DetailTier::FULL ? hysteresis : 0.0f);
+    float reducedLimit = reducedMargin + (previous != DetailTier::DORMANT ? hysteresis : 0.0f);
+    
+    if (distance <= fullLimit) return DetailTier::FULL;
+    if (distance <= reducedLimit) return DetailTier::REDUCED;
+    return DetailTier::DORMANT;
+}
+
+bool SimulationLOD::isScheduled(DetailTier tier, uint32_t index, uint64_t frame) const {
+    switch (tier) {
+        case DetailTier::FULL:
+            return true;
+        case DetailTier::REDUCED:
+            return (frame + index) % static_cast<uint64_t>(reducedInterval) == 0;
+        case DetailTier::DORMANT:
+            return (frame + index) % static_cast<uint64_t>(dormantInterval) == 0;
+    }
+    return true;
+}
\ No newline at end of file
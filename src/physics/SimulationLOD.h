@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Vector2.h"
+
+enum class DetailTier : uint8_t {
+    FULL,
+    REDUCED,
+    DORMANT
+};
+
+struct InterestRegion {
+    Vector2 min;
+    Vector2 max;
+};
+
+class SimulationLOD {
+private:
+    std::vector<InterestRegion> regions;
+    float fullMargin;
+    float reducedMargin;
+    float hysteresis;
+    int reducedInterval;
+    int dormantInterval;
+    int reducedIterations;
+    
+    float distanceToInterest(const Vector2& position) const;
+    
+public:
+    SimulationLOD(float fullMargin = 100.0f, float reducedMargin = 800.0f, float hysteresis = 50.0f);
+    
+    void clearInterest() { regions.clear(); }
+    void addInterestRect(const Vector2& min, const Vector2& max) { regions.push_back({ min, max }); }
+    void addInterestPoint(const Vector2& point, float radius);
+    bool hasInterest() const { return !regions.empty(); }
+    bool covers(const Vector2& min, const Vector2& max, float margin) const;
+    
+    DetailTier classify(const Vector2& position, float extent, DetailTier previous) const;
+    bool isScheduled(DetailTier tier, uint32_t index, uint64_t frame) const;
+    
+    void setMargins(float full, float reduced) { fullMargin = full; reducedMargin = reduced; }
+    void setHysteresis(float distance) { hysteresis = distance; }
+    void setIntervals(int reduced, int dormant) {
+        reducedInterval = reduced > 0 ? reduced : 1;
+        dormantInterval = dormant > 0 ? dormant : 1;
+    }
+    void setReducedIterations(int iterations) { reducedIterations = iterations; }
+    int getReducedIterations() const { return reducedIterations; }
+    float getFullMargin() const { return fullMargin; }
+    float getReducedMargin() const { return reducedMargin; }
+};
\ No newline at end of file
@@ -0,0 +1,391 @@
+#include "SpatialQuery.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+SpatialQuery::SpatialQuery(int width, int height, float cellSize)
+    : cellSize(cellSize) {
+    gridWidth = static_cast<int>(width / cellSize) + 1;
+    gridHeight = static_cast<int>(height / cellSize) + 1;
+    cellStart.assign(gridWidth * gridHeight + 1, 0);
+}
+
+int SpatialQuery::cellX(float x) const {
+    int gx = static_cast<int>(std::floor(x / cellSize));
+    return std::max(0, std::min(gx, gridWidth - 1));
+}
+
+int SpatialQuery::cellY(float y) const {
+    int gy = static_cast<int>(std::floor(y / cellSize));
+    return std::max(0, std::min(gy, gridHeight - 1));
+}
+
+void SpatialQuery::addParticles(const std::vector<Particle>& particles) {
+    for (size_t i = 0; i < particles.size(); i++) {
+        const Particle& p = particles[i];
+        Object object{ p.position, p.radius, 0, 0, 0, ShapeType::CIRCLE,
+                       QueryObjectType::PARTICLE, static_cast<uint32_t>(i), AABB::fromParticle(p) };
+        objects.push_back(object);
+    }
+}
+
+void SpatialQuery::addBody(const Vector2& position, float orientation, ShapeType shape,
+                           float radius, float width, float height, uint32_t index) {
+    Object object{ position, radius, width * 0.5f, height * 0.5f, orientation,
+                   shape, QueryObjectType::RIGID_BODY, index, AABB() };
+    
+    Vector2 extent(radius, radius);
+    if (shape == ShapeType::BOX) {
+        float c = std::abs(std::cos(orientation));
+        float s = std::abs(std::sin(orientation));
+        extent = Vector2(c * object.halfWidth + s * object.halfHeight,
+                         s * object.halfWidth + c * object.halfHeight);
+    }
+    object.bounds = AABB(position - extent, position + extent);
+    objects.push_back(object);
+}
+
+void SpatialQuery::build(const std::vector<Particle>& particles, const std::vector<RigidBody>* bodies) {
+    objects.clear();
+    addParticles(particles);
+    
+    if (bodies) {
+        for (size_t i = 0; i < bodies->size(); i++) {
+            const RigidBody& b = (*bodies)[i];
+            addBody(b.position, b.orientation, b.shapeType, b.radius, b.width, b.height,
+                    static_cast<uint32_t>(i));
+        }
+    }
+    
+    buildCells();
+}
+
+void SpatialQuery::build(const std::vector<Particle>& particles, const std::vector<Vector2>& bodyPositions,
+                         const std::vector<float>& bodyOrientations,
+                         const std::vector<RigidBodyMaterial>& bodyMaterials) {
+    objects.clear();
+    addParticles(particles);
+    
+    for (size_t i = 0; i < bodyPositions.size(); i++) {
+        const RigidBodyMaterial& m = bodyMaterials[i];
+        addBody(bodyPositions[i], bodyOrientations[i], m.shapeType, m.radius, m.width, m.height,
+                static_cast<uint32_t>(i));
+    }
+    
+    buildCells();
+}
+
+void SpatialQuery::buildCells() {
+    worldBounds = AABB(Vector2(0, 0), Vector2(gridWidth * cellSize, gridHeight * cellSize));
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+    for (const auto& object : objects) {
+        worldBounds.min.x = std::min(worldBounds.min.x, object.bounds.min.x);
+        worldBounds.min.y = std::min(worldBounds.min.y, object.bounds.min.y);
+        worldBounds.max.x = std::max(worldBounds.max.x, object.bounds.max.x);
+        worldBounds.max.y = std::max(worldBounds.max.y, object.bounds.max.y);
+        for (int x = cellX(object.bounds.min.x); x <= cellX(object.bounds.max.x); x++) {
+            for (int y = cellY(object.bounds.min.y); y <= cellY(object.bounds.max.y); y++) {
+                cellStart[x * gridHeight + y + 1]++;
+            }
+        }
+    }
+    for (size_t i = 1; i < cellStart.size(); i++) {
+        cellStart[i] += cellStart[i - 1];
+    }
+    
+    cellItems.resize(cellStart.back());
+    cursor.assign(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < objects.size(); i++) {
+        const Object& object = objects[i];
+        for (int x = cellX(object.bounds.min.x); x <= cellX(object.bounds.max.x); x++) {
+            for (int y = cellY(object.bounds.min.y); y <= cellY(object.bounds.max.y); y++) {
+                cellItems[cursor[x * gridHeight + y]++] = static_cast<uint32_t>(i);
+            }
+        }
+    }
+}
+
+QueryHit SpatialQuery::makeHit(const Object& object, float distance, const Vector2& point) const {
+    return { object.index, object.type, distance, point, Vector2(0, 0) };
+}
+
+float SpatialQuery::distanceToObject(const Object& object, const Vector2& point) const {
+    if (object.shape == ShapeType::CIRCLE) {
+        return std::max(0.0f, Vector2::distance(point, object.position) - object.radius);
+    }
+    
+    Vector2 local = Vector2::rotate(point - object.position, -object.orientation);
+    float dx = std::max(std::abs(local.x) - object.halfWidth, 0.0f);
+    float dy = std::max(std::abs(local.y) - object.halfHeight, 0.0f);
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+bool SpatialQuery::overlapsRegion(const Object& object, const AABB& region) const {
+    if (object.shape == ShapeType::CIRCLE) {
+        Vector2 closest(std::max(region.min.x, std::min(object.position.x, region.max.x)),
+                        std::max(region.min.y, std::min(object.position.y, region.max.y)));
+        return Vector2::distanceSquared(closest, object.position) <= object.radius * object.radius;
+    }
+    
+    float c = std::cos(object.orientation);
+    float s = std::sin(object.orientation);
+    float centerX = (region.min.x + region.max.x) * 0.5f - object.position.x;
+    float centerY = (region.min.y + region.max.y) * 0.5f - object.position.y;
+    float halfX = (region.max.x - region.min.x) * 0.5f;
+    float halfY = (region.max.y - region.min.y) * 0.5f;
+    
+    float alongX = std::abs(centerX * c + centerY * s);
+    float reachX = object.halfWidth + halfX * std::abs(c) + halfY * std::abs(s);
+    if (alongX > reachX) return false;
+    
+    float alongY = std::abs(centerY * c - centerX * s);
+    float reachY = object.halfHeight + halfX * std::abs(s) + halfY * std::abs(c);
+    return alongY <= reachY;
+}
+
+bool SpatialQuery::raycastObject(const Object& object, const Ray& ray, QueryHit& hit) const {
+    if (object.shape == ShapeType::CIRCLE) {
+        Vector2 m = ray.origin - object.position;
+        float b = m.dot(ray.direction);
+        float c = m.magnitudeSquared() - object.radius * object.radius;
+        if (c > 0 && b > 0) return false;
+        
+        float discriminant = b * b - c;
+        if (discriminant < 0) return false;
+        
+        float t = std::max(0.0f, -b - std::sqrt(discriminant));
+        if (t > ray.maxDistance) return false;
+        
+        hit = makeHit(object, t, ray.origin + ray.direction * t);
+        hit.normal = c > 0 ? (hit.point - object.position).normalize() : ray.direction * -1.0f;
+        return true;
+    }
+    
+    Vector2 origin = Vector2::rotate(ray.origin - object.position, -object.orientation);
+    Vector2 direction = Vector2::rotate(ray.direction, -object.orientation);
+    
+    float tMin = 0.0f;
+    float tMax = ray.maxDistance;
+    Vector2 localNormal(0, 0);
+    float origins[2] = { origin.x, origin.y };
+    float directions[2] = { direction.x, direction.y };
+    float extents[2] = { object.halfWidth, object.halfHeight };
+    
+    for (int axis = 0; axis < 2; axis++) {
+        if (std::abs(directions[axis]) < 1e-8f) {
+            if (std::abs(origins[axis]) > extents[axis]) return false;
+            continue;
+        }
+        
+        float inv = 1.0f / directions[axis];
+        float t1 = (-extents[axis] - origins[axis]) * inv;
+        float t2 = (extents[axis] - origins[axis]) * inv;
+        float sign = -1.0f;
+        if (t1 > t2) {
+            std::swap(t1, t2);
+            sign = 1.0f;
+        }
+        
+        if (t1 > tMin) {
+            tMin = t1;
+            localNormal = axis == 0 ? Vector2(sign, 0) : Vector2(0, sign);
+        }
+        tMax = std::min(tMax, t2);
+        if (tMin > tMax) return false;
+    }
+    
+    hit = makeHit(object, tMin, ray.origin + ray.direction * tMin);
+    hit.normal = localNormal.magnitudeSquared() > 0
+        ? Vector2::rotate(localNormal, object.orientation)
+        : ray.direction * -1.0f;
+    return true;
+}
+
+bool SpatialQuery::raycast(const Ray& ray, QueryHit& hit) const {
+    if (objects.empty()) return false;
+    
+    const AABB& bounds = worldBounds;
+    float tEnter = 0.0f;
+    float tLeave = ray.maxDistance;
+    float origins[2] = { ray.origin.x, ray.origin.y };
+    float directions[2] = { ray.direction.x, ray.direction.y };
+    float mins[2] = { bounds.min.x, bounds.min.y };
+    float maxs[2] = { bounds.max.x, bounds.max.y };
+    for (int axis = 0; axis < 2; axis++) {
+        if (std::abs(directions[axis]) < 1e-8f) {
+            if (origins[axis] < mins[axis] || origins[axis] > maxs[axis]) return false;
+            continue;
+        }
+        float t1 = (mins[axis] - origins[axis]) / directions[axis];
+        float t2 = (maxs[axis] - origins[axis]) / directions[axis];
+        if (t1 > t2) std::swap(t1, t2);
+        tEnter = std::max(tEnter, t1);
+        tLeave = std::min(tLeave, t2);
+    }
+    if (tEnter > tLeave) return false;
+    
+    Vector2 start = ray.origin + ray.direction * tEnter;
+    int x = static_cast<int>(std::floor(start.x / cellSize));
+    int y = static_cast<int>(std::floor(start.y / cellSize));
+    int stepX = ray.direction.x > 0 ? 1 : -1;
+    int stepY = ray.direction.y > 0 ? 1 : -1;
+    
+    const float infinity = std::numeric_limits<float>::infinity();
+    float deltaX = std::abs(ray.direction.x) > 1e-8f ? cellSize / std::abs(ray.direction.x) : infinity;
+    float deltaY = std::abs(ray.direction.y) > 1e-8f ? cellSize / std::abs(ray.direction.y) : infinity;
+    float nextX = deltaX == infinity ? infinity
+        : tEnter + ((stepX > 0 ? (x + 1) * cellSize - start.x : start.x - x * cellSize) / std::abs(ray.direction.x));
+    float nextY = deltaY == infinity ? infinity
+        : tEnter + ((stepY > 0 ? (y + 1) * cellSize - start.y : start.y - y * cellSize) / std::abs(ray.direction.y));
+    
+    bool found = false;
+    int lastCell = -1;
+    float t = tEnter;
+    
+    while (t <= tLeave) {
+        int cx = std::max(0, std::min(x, gridWidth - 1));
+        int cy = std::max(0, std::min(y, gridHeight - 1));
+        int cell = cx * gridHeight + cy;
+        
+        if (cell != lastCell) {
+            for (uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; i++) {
+                QueryHit candidate;
+                if (raycastObject(objects[cellItems[i]], ray, candidate) &&
+                    (!found || candidate.distance < hit.distance)) {
+                    hit = candidate;
+                    found = true;
+                }
+            }
+            lastCell = cell;
+        }
+        
+        float cellExit = std::min(nextX, nextY);
+        if (found && hit.distance <= cellExit) break;
+        
+        if (nextX < nextY) {
+            x += stepX;
+            t = nextX;
+            nextX += deltaX;
+        } else {
+            y += stepY;
+            t = nextY;
+            nextY += deltaY;
+        }
+    }
+    
+    return found;
+}
+
+void SpatialQuery::raycastBatch(const std::vector<Ray>& rays, std::vector<QueryHit>& hits,
+                                std::vector<uint8_t>& hitFlags, ThreadPool& pool) const {
+    hits.resize(rays.size());
+    hitFlags.resize(rays.size());
+    
+    pool.parallelFor(rays.size(), 64, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            hitFlags[i] = raycast(rays[i], hits[i]) ? 1 : 0;
+        }
+    });
+}
+
+void SpatialQuery::queryAABB(const AABB& region, std::vector<QueryHit>& out) const {
+    for (int x = cellX(region.min.x); x <= cellX(region.max.x); x++) {
+        for (int y = cellY(region.min.y); y <= cellY(region.max.y); y++) {
+            int cell = x * gridHeight + y;
+            for (uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; i++) {
+                const Object& object = objects[cellItems[i]];
+                if (!object.bounds.intersects(region)) continue;
+                
+                float refX = std::max(object.bounds.min.x, region.min.x);
+                float refY = std::max(object.bounds.min.y, region.min.y);
+                if (cellX(refX) != x || cellY(refY) != y) continue;
+                
+                if (!overlapsRegion(object, region)) continue;
+                
+                out.push_back(makeHit(object, 0.0f, object.position));
+            }
+        }
+    }
+}
+
+void SpatialQuery::queryCircle(const Vector2& center, float radius, std::vector<QueryHit>& out) const {
+    AABB region(center - Vector2(radius, radius), center + Vector2(radius, radius));
+    
+    for (int x = cellX(region.min.x); x <= cellX(region.max.x); x++) {
+        for (int y = cellY(region.min.y); y <= cellY(region.max.y); y++) {
+            int cell = x * gridHeight + y;
+            for (uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; i++) {
+                const Object& object = objects[cellItems[i]];
+                if (!object.bounds.intersects(region)) continue;
+                
+                float refX = std::max(object.bounds.min.x, region.min.x);
+                float refY = std::max(object.bounds.min.y, region.min.y);
+                if (cellX(refX) != x || cellY(refY) != y) continue;
+                
+                float distance = distanceToObject(object, center);
+                if (distance > radius) continue;
+                
+                out.push_back(makeHit(object, distance, object.position));
+            }
+        }
+    }
+}
+
+void SpatialQuery::nearest(const Vector2& point, size_t k, std::vector<QueryHit>& out) const {
+    if (k == 0 || objects.empty()) return;
+    
+    size_t base = out.size();
+    auto first = [&] { return out.begin() + base; };
+    auto closer = [](const QueryHit& a, const QueryHit& b) { return a.distance < b.distance; };
+    
+    int cx = cellX(point.x);
+    int cy = cellY(point.y);
+    bool inside = point.x >= 0 && point.y >= 0 &&
+                  point.x < gridWidth * cellSize && point.y < gridHeight * cellSize;
+    int maxRing = std::max(gridWidth, gridHeight);
+    
+    for (int ring = 0; ring <= maxRing; ring++) {
+        for (int x = cx - ring; x <= cx + ring; x++) {
+            if (x < 0 || x >= gridWidth) continue;
+            for (int y = cy - ring; y <= cy + ring; y++) {
+                if (y < 0 || y >= gridHeight) continue;
+                if (std::abs(x - cx) != ring && std::abs(y - cy) != ring) continue;
+                
+                int cell = x * gridHeight + y;
+                for (uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; i++) {
+                    const Object& object = objects[cellItems[i]];
+                    
+                    bool duplicate = false;
+                    for (size_t h = base; h < out.size(); h++) {
+                        const QueryHit& hit = out[h];
+                        if (hit.index == object.index && hit.type == object.type) {
+                            duplicate = true;
+                            break;
+                        }
+                    }
+                    if (duplicate) continue;
+                    
+                    float distance = distanceToObject(object, point);
+                    if (out.size() - base == k && distance >= out[base].distance) continue;
+                    
+                    out.push_back(makeHit(object, distance, object.position));
+                    std::push_heap(first(), out.end(), closer);
+                    if (out.size() - base > k) {
+                        std::pop_heap(first(), out.end(), closer);
+                        out.pop_back();
+                    }
+                }
+            }
+        }
+        
+        if (out.size() - base == k && inside) {
+            float reach = std::min({ point.x - (cx - ring) * cellSize,
+                                     (cx + ring + 1) * cellSize - point.x,
+                                     point.y - (cy - ring) * cellSize,
+                                     (cy + ring + 1) * cellSize - point.y });
+            if (out[base].distance <= reach) break;
+        }
+    }
+    
+    std::sort_heap(first(), out.end(), closer);
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+#include "Vector2.h"
+#include "Particle.h"
+#include "RigidBody.h"
+#include "Collision.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <vector>
+
+enum class QueryObjectType : uint8_t {
+    PARTICLE,
+    RIGID_BODY
+};
+
+struct Ray {
+    Vector2 origin;
+    Vector2 direction;
+    float maxDistance;
+    
+    Ray() : origin(0, 0), direction(1, 0), maxDistance(1e30f) {}
+    Ray(const Vector2& o, const Vector2& d, float maxDist = 1e30f)
+        : origin(o), direction(d.normalize()), maxDistance(maxDist) {}
+};
+
+struct QueryHit {
+    uint32_t index;
+    QueryObjectType type;
+    float distance;
+    Vector2 point;
+    Vector2 normal;
+};
+
+class SpatialQuery {
+private:
+    struct Object {
+        Vector2 position;
+        float radius;
+        float halfWidth;
+        float halfHeight;
+        float orientation;
+        ShapeType shape;
+        QueryObjectType type;
+        uint32_t index;
+        AABB bounds;
+    };
+    
+    float cellSize;
+    int gridWidth;
+    int gridHeight;
+    std::vector<Object> objects;
+    std::vector<uint32_t> cellStart;
+    std::vector<uint32_t> cellItems;
+    std::vector<uint32_t> cursor;
+    AABB worldBounds;
+    
+    int cellX(float x) const;
+    int cellY(float y) const;
+    
+    bool raycastObject(const Object& object, const Ray& ray, QueryHit& hit) const;
+    float distanceToObject(const Object& object, const Vector2& point) const;
+    bool overlapsRegion(const Object& object, const AABB& region) const;
+    QueryHit makeHit(const Object& object, float distance, const Vector2& point) const;
+    
+    void addParticles(const std::vector<Particle>& particles);
+    void addBody(const Vector2& position, float orientation, ShapeType shape,
+                 float radius, float width, float height, uint32_t index);
+    void buildCells();
+    
+public:
+    SpatialQuery(int width, int height, float cellSize);
+    
+    void build(const std::vector<Particle>& particles, const std::vector<RigidBody>* bodies = nullptr);
+    void build(const std::vector<Particle>& particles, const std::vector<Vector2>& bodyPositions,
+               const std::vector<float>& bodyOrientations, const std::vector<RigidBodyMaterial>& bodyMaterials);
+    
+    bool raycast(const Ray& ray, QueryHit& hit) const;
+    void raycastBatch(const std::vector<Ray>& rays, std::vector<QueryHit>& hits,
+                      std::vector<uint8_t>& hitFlags, ThreadPool& pool) const;
+    
+    void queryAABB(const AABB& region, std::vector<QueryHit>& out) const;
+    void queryCircle(const Vector2& center, float radius, std::vector<QueryHit>& out) const;
+    void nearest(const Vector2& point, size_t k, std::vector<QueryHit>& out) const;
+    
+    size_t size() const { return objects.size(); }
+};
\ No newline at end of file
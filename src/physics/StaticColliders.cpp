@@ -0,0 +1,192 @@
+#include "StaticColliders.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+size_t StaticColliders::addShape(StaticShapeType type, const Vector2* points, size_t count, float thickness,
+                                 float restitution, float friction) {
+    if (count == 0) return INVALID_SHAPE;
+    
+    StaticShape shape;
+    shape.type = type;
+    shape.firstVertex = static_cast<uint32_t>(vertices.size());
+    shape.vertexCount = static_cast<uint32_t>(count);
+    shape.thickness = thickness;
+    shape.restitution = restitution;
+    shape.friction = friction;
+    shape.min = points[0];
+    shape.max = points[0];
+    
+    float area = 0.0f;
+    for (size_t i = 0; i < count; i++) {
+        const Vector2& p = points[i];
+        shape.min = Vector2(std::min(shape.min.x, p.x), std::min(shape.min.y, p.y));
+        shape.max = Vector2(std::max(shape.max.x, p.x), std::max(shape.max.y, p.y));
+        area += p.cross(points[(i + 1) % count]);
+    }
+    shape.min = shape.min - Vector2(thickness, thickness);
+    shape.max = shape.max + Vector2(thickness, thickness);
+    
+    if (count >= 3 && area < 0.0f) {
+        for (size_t i = count; i > 0; i--) vertices.push_back(points[i - 1]);
+    } else {
+        vertices.insert(vertices.end(), points, points + count);
+    }
+    
+    shapes.push_back(shape);
+    built = false;
+    return shapes.size() - 1;
+}
+
+size_t StaticColliders::addSegment(const Vector2& a, const Vector2& b, float thickness,
+                                   float restitution, float friction) {
+    Vector2 points[2] = { a, b };
+    return addShape(StaticShapeType::SEGMENT, points, 2, thickness, restitution, friction);
+}
+
+size_t StaticColliders::addBox(const Vector2& center, float width, float height, float orientation,
+                               float restitution, float friction) {
+    float c = std::cos(orientation);
+    float s = std::sin(orientation);
+    Vector2 axisX(c * width * 0.5f, s * width * 0.5f);
+    Vector2 axisY(-s * height * 0.5f, c * height * 0.5f);
+    Vector2 points[4] = { center - axisX - axisY, center + axisX - axisY,
+                          center + axisX + axisY, center - axisX + axisY };
+    return addShape(StaticShapeType::BOX, points, 4, 0.0f, restitution, friction);
+}
+
+size_t StaticColliders::addPolygon(const std::vector<Vector2>& points, float restitution, float friction) {
+    if (points.size() < 3) return INVALID_SHAPE;
+    return addShape(StaticShapeType::POLYGON, points.data(), points.size(), 0.0f, restitution, friction);
+}
+
+void StaticColliders::clear() {
+    shapes.clear();
+    vertices.clear();
+    nodes.clear();
+    order.clear();
+    built = false;
+}
+
+void StaticColliders::build() {
+    nodes.clear();
+    order.resize(shapes.size());
+    for (size_t i = 0; i < shapes.size(); i++) {
+        order[i] = static_cast<uint32_t>(i);
+    }
+    
+    if (!shapes.empty()) {
+        nodes.reserve(2 * shapes.size() / LEAF_SIZE + 1);
+        buildNode(0, static_cast<uint32_t>(shapes.size()));
+    }
+    built = true;
+}
+
+uint32_t StaticColliders::buildNode(uint32_t begin, uint32_t end) {
+    uint32_t index = static_cast<uint32_t>(nodes.size());
+    nodes.push_back(Node());
+    
+    Vector2 min = shapes[order[begin]].min;
+    Vector2 max = shapes[order[begin]].max;
+    Vector2 centroidMin = (min + max) * 0.5f;
+    Vector2 centroidMax = centroidMin;
+    for (uint32_t i = begin; i < end; i++) {
+        const StaticShape& shape = shapes[order[i]];
+        Vector2 centroid = (shape.min + shape.max) * 0.5f;
+        min = Vector2(std::min(min.x, shape.min.x), std::min(min.y, shape.min.y));
+        max = Vector2(std::max(max.x, shape.max.x), std::max(max.y, shape.max.y));
+        centroidMin = Vector2(std::min(centroidMin.x, centroid.x), std::min(centroidMin.y, centroid.y));
+        centroidMax = Vector2(std::max(centroidMax.x, centroid.x), std::max(centroidMax.y, centroid.y));
+    }
+    nodes[index].min = min;
+    nodes[index].max = max;
+    
+    if (end - begin <= LEAF_SIZE) {
+        nodes[index].first = begin;
+        nodes[index].count = end - begin;
+        nodes[index].right = 0;
+        return index;
+    }
+    
+    bool splitX = centroidMax.x - centroidMin.x >= centroidMax.y - centroidMin.y;
+    uint32_t mid = begin + (end - begin) / 2;
+    std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                     [&](uint32_t a, uint32_t b) {
+                         const StaticShape& sa = shapes[a];
+                         const StaticShape& sb = shapes[b];
+                         return splitX ? sa.min.x + sa.max.x < sb.min.x + sb.max.x
+                                       : sa.min.y + sa.max.y < sb.min.y + sb.max.y;
+                     });
+    
+    buildNode(begin, mid);
+    uint32_t right = buildNode(mid, end);
+    nodes[index].first = 0;
+    nodes[index].count = 0;
+    nodes[index].right = right;
+    return index;
+}
+
+bool StaticColliders::circleContact(uint32_t index, const Vector2& center, float radius,
+                                    StaticContact& contact) const {
+    const StaticShape& shape = shapes[index];
+    const Vector2* points = vertices.data() + shape.firstVertex;
+    uint32_t count = shape.vertexCount;
+    float reach = radius + shape.thickness;
+    
+    if (count >= 3) {
+        float maxSeparation = -std::numeric_limits<float>::max();
+        Vector2 faceNormal(0, 0);
+        for (uint32_t i = 0; i < count; i++) {
+            Vector2 edge = points[(i + 1) % count] - points[i];
+            Vector2 normal = Vector2(edge.y, -edge.x).normalize();
+            float separation = (center - points[i]).dot(normal);
+            if (separation > reach) return false;
+            if (separation > maxSeparation) {
+                maxSeparation = separation;
+                faceNormal = normal;
+            }
+        }
+        
+        if (maxSeparation <= 0.0f) {
+            contact.shape = index;
+            contact.normal = faceNormal;
+            contact.penetration = reach - maxSeparation;
+            contact.contactPoint = center - faceNormal * maxSeparation;
+            return true;
+        }
+    }
+    
+    float bestDistanceSquared = std::numeric_limits<float>::max();
+    Vector2 closest(0, 0);
+    uint32_t edges = count >= 3 ? count : 1;
+    for (uint32_t i = 0; i < edges; i++) {
+        const Vector2& a = points[i];
+        Vector2 edge = points[(i + 1) % count] - a;
+        float lengthSquared = edge.magnitudeSquared();
+        float t = lengthSquared > 0.0f ? (center - a).dot(edge) / lengthSquared : 0.0f;
+        t = std::max(0.0f, std::min(1.0f, t));
+        Vector2 candidate = a + edge * t;
+        float distanceSquared = (center - candidate).magnitudeSquared();
+        if (distanceSquared < bestDistanceSquared) {
+            bestDistanceSquared = distanceSquared;
+            closest = candidate;
+        }
+    }
+    
+    if (bestDistanceSquared > reach * reach) return false;
+    
+    float distance = std::sqrt(bestDistanceSquared);
+    Vector2 normal;
+    if (distance > 0.0f) {
+        normal = (center - closest) / distance;
+    } else {
+        Vector2 edge = points[1 % count] - points[0];
+        normal = Vector2(-edge.y, edge.x).normalize();
+    }
+    
+    contact.shape = index;
+    contact.normal = normal;
+    contact.penetration = reach - distance;
+    contact.contactPoint = closest + normal * shape.thickness;
+    return true;
+}
\ No newline at end of file
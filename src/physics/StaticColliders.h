@@ -0,0 +1,101 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Vector2.h"
+
+enum class StaticShapeType : uint8_t {
+    SEGMENT,
+    BOX,
+    POLYGON
+};
+
+struct StaticShape {
+    StaticShapeType type;
+    uint32_t firstVertex;
+    uint32_t vertexCount;
+    float thickness;
+    float restitution;
+    float friction;
+    Vector2 min;
+    Vector2 max;
+};
+
+struct StaticContact {
+    uint32_t shape;
+    Vector2 contactPoint;
+    Vector2 normal;
+    float penetration;
+};
+
+class StaticColliders {
+private:
+    struct Node {
+        Vector2 min;
+        Vector2 max;
+        uint32_t first;
+        uint32_t count;
+        uint32_t right;
+    };
+    
+    std::vector<StaticShape> shapes;
+    std::vector<Vector2> vertices;
+    std::vector<Node> nodes;
+    std::vector<uint32_t> order;
+    bool built;
+    
+    size_t addShape(StaticShapeType type, const Vector2* points, size_t count, float thickness,
+                    float restitution, float friction);
+    uint32_t buildNode(uint32_t begin, uint32_t end);
+    bool circleContact(uint32_t shape, const Vector2& center, float radius, StaticContact& contact) const;
+    
+public:
+    static const int MAX_DEPTH = 64;
+    static const uint32_t LEAF_SIZE = 4;
+    static const size_t INVALID_SHAPE = SIZE_MAX;
+    
+    StaticColliders() : built(false) {}
+    
+    size_t addSegment(const Vector2& a, const Vector2& b, float thickness = 0.0f,
+                      float restitution = 0.5f, float friction = 0.3f);
+    size_t addBox(const Vector2& center, float width, float height, float orientation = 0.0f,
+                  float restitution = 0.5f, float friction = 0.3f);
+    size_t addPolygon(const std::vector<Vector2>& points, float restitution = 0.5f, float friction = 0.3f);
+    void build();
+    void clear();
+    
+    template <typename Fn>
+    void queryCircle(const Vector2& center, float radius, Fn&& fn) const {
+        assert(built || shapes.empty());
+        if (nodes.empty()) return;
+        
+        uint32_t stack[MAX_DEPTH];
+        int top = 0;
+        stack[top++] = 0;
+        StaticContact contact;
+        
+        while (top > 0) {
+            uint32_t index = stack[--top];
+            const Node& node = nodes[index];
+            if (center.x + radius < node.min.x || center.x - radius > node.max.x ||
+                center.y + radius < node.min.y || center.y - radius > node.max.y) continue;
+            
+            if (node.count > 0) {
+                for (uint32_t k = node.first; k < node.first + node.count; k++) {
+                    if (circleContact(order[k], center, radius, contact)) fn(contact);
+                }
+            } else {
+                stack[top++] = node.right;
+                stack[top++] = index + 1;
+            }
+        }
+    }
+    
+    size_t size() const { return shapes.size(); }
+    bool empty() const { return shapes.empty(); }
+    bool isBuilt() const { return built; }
+    size_t getNodeCount() const { return nodes.size(); }
+    const StaticShape& getShape(size_t i) const { return shapes[i]; }
+    const Vector2* getVertices(size_t i) const { return vertices.data() + shapes[i].firstVertex; }
+};
\ No newline at end of file
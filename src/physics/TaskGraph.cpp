@@ -0,0 +1,177 @@
+#include "TaskGraph.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+size_t TaskGraph::addTask(const std::string& name, ResourceMask reads, ResourceMask writes,
+                          std::function<void()> fn) {
+    return addChunkedTask(name, reads, writes, 1, 1,
+                          [fn = std::move(fn)](size_t, size_t) { fn(); });
+}
+
+size_t TaskGraph::addChunkedTask(const std::string& name, ResourceMask reads, ResourceMask writes,
+                                 size_t count, size_t grain, std::function<void(size_t, size_t)> fn) {
+    Task task;
+    task.name = name;
+    task.reads = reads;
+    task.writes = writes;
+    task.count = count;
+    task.grain = std::max<size_t>(grain, 1);
+    task.body = std::move(fn);
+    task.dependencies = 0;
+    task.pendingDependencies = 0;
+    task.pendingChunks = 0;
+    task.started = false;
+    
+    tasks.push_back(std::move(task));
+    compiled = false;
+    return tasks.size() - 1;
+}
+
+size_t TaskGraph::addDynamicTask(const std::string& name, ResourceMask reads, ResourceMask writes,
+                                 size_t grain, std::function<size_t()> prepare,
+                                 std::function<void(size_t, size_t)> fn) {
+    size_t index = addChunkedTask(name, reads, writes, 0, grain, std::move(fn));
+    tasks[index].prepare = std::move(prepare);
+    return index;
+}
+
+size_t TaskGraph::addPipeline(const std::string& name, ResourceMask reads, ResourceMask writes,
+                              size_t count, size_t grain,
+                              std::vector<std::function<void(size_t, size_t)>> stages) {
+    return addChunkedTask(name, reads, writes, count, grain,
+        [stages = std::move(stages)](size_t begin, size_t end) {
+            for (const auto& stage : stages) {
+                stage(begin, end);
+            }
+        });
+}
+
+void TaskGraph::clear() {
+    tasks.clear();
+    compiled = false;
+}
+
+size_t TaskGraph::chunkCount(const Task& task) const {
+    return std::max<size_t>(1, (task.count + task.grain - 1) / task.grain);
+}
+
+void TaskGraph::compile() {
+    if (compiled) return;
+    
+    for (auto& task : tasks) {
+        task.successors.clear();
+        task.dependencies = 0;
+    }
+    
+    for (size_t j = 0; j < tasks.size(); j++) {
+        for (size_t i = 0; i < j; i++) {
+            const Task& before = tasks[i];
+            const Task& after = tasks[j];
+            bool conflict = (before.writes & (after.reads | after.writes)) ||
+                            (before.reads & after.writes);
+            if (conflict) {
+                tasks[i].successors.push_back(static_cast<uint32_t>(j));
+                tasks[j].dependencies++;
+            }
+        }
+    }
+    
+    compiled = true;
+}
+
+void TaskGraph::run(ThreadPool& pool) {
+    if (tasks.empty()) return;
+    compile();
+    
+    const uint32_t prepareChunk = UINT32_MAX;
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<WorkItem> queue;
+    size_t remainingTasks = tasks.size();
+    
+    auto enqueueChunks = [&](uint32_t index) {
+        Task& task = tasks[index];
+        uint32_t chunks = static_cast<uint32_t>(chunkCount(task));
+        task.pendingChunks = chunks;
+        for (uint32_t c = 0; c < chunks; c++) {
+            queue.push_back({ index, c });
+        }
+    };
+    
+    auto enqueue = [&](uint32_t index) {
+        if (tasks[index].prepare) {
+            tasks[index].pendingChunks = 1;
+            queue.push_back({ index, prepareChunk });
+        } else {
+            enqueueChunks(index);
+        }
+    };
+    
+    for (size_t i = 0; i < tasks.size(); i++) {
+        tasks[i].pendingDependencies = tasks[i].dependencies;
+        tasks[i].started = false;
+        if (tasks[i].dependencies == 0) {
+            enqueue(static_cast<uint32_t>(i));
+        }
+    }
+    
+    pool.run(pool.size(), [&](size_t) {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            ready.wait(lock, [&] { return !queue.empty() || remainingTasks == 0; });
+            if (remainingTasks == 0) return;
+            
+            WorkItem item = queue.front();
+            queue.pop_front();
+            Task& task = tasks[item.task];
+            if (!task.started) {
+                task.started = true;
+                task.start = Clock::now();
+            }
+            lock.unlock();
+            
+            if (item.chunk == prepareChunk) {
+                size_t count = task.prepare();
+                lock.lock();
+                task.count = count;
+                if (count > 0) {
+                    enqueueChunks(item.task);
+                    ready.notify_all();
+                    continue;
+                }
+            } else {
+                size_t begin = static_cast<size_t>(item.chunk) * task.grain;
+                size_t end = std::min(begin + task.grain, task.count);
+                task.body(begin, std::max(begin, end));
+                
+                lock.lock();
+                if (--task.pendingChunks > 0) continue;
+            }
+            
+            double ms = std::chrono::duration<double, std::milli>(Clock::now() - task.start).count();
+            TaskStats& s = stats[task.name];
+            s.name = task.name;
+            s.lastMs = ms;
+            s.averageMs = (s.averageMs * s.runs + ms) / (s.runs + 1);
+            s.runs++;
+            
+            for (uint32_t successor : task.successors) {
+                if (--tasks[successor].pendingDependencies == 0) {
+                    enqueue(successor);
+                }
+            }
+            remainingTasks--;
+            ready.notify_all();
+        }
+    });
+}
+
+std::vector<TaskStats> TaskGraph::getStats() const {
+    std::vector<TaskStats> result;
+    for (const auto& entry : stats) {
+        result.push_back(entry.second);
+    }
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+#include "ThreadPool.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+using ResourceMask = uint32_t;
+
+enum SimResource : ResourceMask {
+    RESOURCE_PARTICLE_STATE = 1u << 0,
+    RESOURCE_PARTICLE_FORCES = 1u << 1,
+    RESOURCE_PARTICLE_GRID = 1u << 2,
+    RESOURCE_QUERY_INDEX = 1u << 3,
+    RESOURCE_RIGID_STATE = 1u << 4,
+    RESOURCE_RIGID_FORCES = 1u << 5,
+    RESOURCE_RIGID_CONTACTS = 1u << 6
+};
+
+struct TaskStats {
+    std::string name;
+    double lastMs;
+    double averageMs;
+    size_t runs;
+};
+
+class TaskGraph {
+private:
+    using Clock = std::chrono::steady_clock;
+    
+    struct Task {
+        std::string name;
+        ResourceMask reads;
+        ResourceMask writes;
+        size_t count;
+        size_t grain;
+        std::function<void(size_t, size_t)> body;
+        std::function<size_t()> prepare;
+        std::vector<uint32_t> successors;
+        uint32_t dependencies;
+        uint32_t pendingDependencies;
+        uint32_t pendingChunks;
+        Clock::time_point start;
+        bool started;
+    };
+    
+    struct WorkItem {
+        uint32_t task;
+        uint32_t chunk;
+    };
+    
+    std::vector<Task> tasks;
+    std::map<std::string, TaskStats> stats;
+    bool compiled;
+    
+    void compile();
+    size_t chunkCount(const Task& task) const;
+    
+public:
+    TaskGraph() : compiled(false) {}
+    
+    size_t addTask(const std::string& name, ResourceMask reads, ResourceMask writes,
+                   std::function<void()> fn);
+    size_t addChunkedTask(const std::string& name, ResourceMask reads, ResourceMask writes,
+                          size_t count, size_t grain, std::function<void(size_t, size_t)> fn);
+    size_t addDynamicTask(const std::string& name, ResourceMask reads, ResourceMask writes,
+                          size_t grain, std::function<size_t()> prepare,
+                          std::function<void(size_t, size_t)> fn);
+    size_t addPipeline(const std::string& name, ResourceMask reads, ResourceMask writes,
+                       size_t count, size_t grain,
+                       std::vector<std::function<void(size_t, size_t)>> stages);
+    
+    void run(ThreadPool& pool);
+    void clear();
+    
+    size_t size() const { return tasks.size(); }
+    std::vector<TaskStats> getStats() const;
+};
\ No newline at end of file
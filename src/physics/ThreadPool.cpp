@@ -0,0 +1,187 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+static thread_local bool insidePool = false;
+
+static uint64_t packRange(uint32_t begin, uint32_t end) {
+    return (static_cast<uint64_t>(begin) << 32) | end;
+}
+
+ThreadPool::ThreadPool(size_t threadCount)
+    : job(nullptr), jobCount(0), nextItem(0), generation(0),
+      busyWorkers(0), stopping(false), stealing(false) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    ranges.reset(new StealRange[threadCount]);
+    for (size_t i = 0; i < threadCount; i++) {
+        ranges[i].range.store(0, std::memory_order_relaxed);
+    }
+    
+    for (size_t i = 1; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::drain(size_t index) {
+    if (stealing) {
+        drainStealing(index);
+        return;
+    }
+    
+    for (;;) {
+        size_t item = nextItem.fetch_add(1, std::memory_order_relaxed);
+        if (item >= jobCount) break;
+        (*job)(item);
+    }
+}
+
+bool ThreadPool::popRange(size_t index, size_t& item) {
+    std::atomic<uint64_t>& range = ranges[index].range;
+    uint64_t current = range.load(std::memory_order_acquire);
+    for (;;) {
+        uint32_t begin = static_cast<uint32_t>(current >> 32);
+        uint32_t end = static_cast<uint32_t>(current);
+        if (begin >= end) return false;
+        if (range.compare_exchange_weak(current, packRange(begin + 1, end), std::memory_order_acq_rel)) {
+            item = begin;
+            return true;
+        }
+    }
+}
+
+bool ThreadPool::stealRange(size_t victim, uint32_t& begin, uint32_t& end) {
+    std::atomic<uint64_t>& range = ranges[victim].range;
+    uint64_t current = range.load(std::memory_order_acquire);
+    for (;;) {
+        uint32_t victimBegin = static_cast<uint32_t>(current >> 32);
+        uint32_t victimEnd = static_cast<uint32_t>(current);
+        if (victimBegin >= victimEnd) return false;
+        
+        uint32_t split = victimEnd - (victimEnd - victimBegin + 1) / 2;
+        if (range.compare_exchange_weak(current, packRange(victimBegin, split), std::memory_order_acq_rel)) {
+            begin = split;
+            end = victimEnd;
+            return true;
+        }
+    }
+}
+
+void ThreadPool::drainStealing(size_t index) {
+    size_t participants = size();
+    
+    for (;;) {
+        size_t item;
+        while (popRange(index, item)) {
+            (*job)(item);
+        }
+        
+        bool stolen = false;
+        for (size_t k = 1; k < participants && !stolen; k++) {
+            uint32_t begin, end;
+            if (stealRange((index + k) % participants, begin, end)) {
+                ranges[index].range.store(packRange(begin, end), std::memory_order_release);
+                stolen = true;
+            }
+        }
+        if (!stolen) return;
+    }
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    insidePool = true;
+    size_t seenGeneration = 0;
+    
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+        }
+        
+        drain(index);
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busyWorkers--;
+        }
+        doneCondition.notify_one();
+    }
+}
+
+void ThreadPool::run(size_t count, const std::function<void(size_t)>& fn) {
+    dispatch(count, fn, false);
+}
+
+void ThreadPool::runStealing(size_t count, const std::function<void(size_t)>& fn) {
+    dispatch(count, fn, true);
+}
+
+void ThreadPool::dispatch(size_t count, const std::function<void(size_t)>& fn, bool steal) {
+    if (count == 0) return;
+    
+    if (workers.empty() || count == 1 || insidePool) {
+        for (size_t i = 0; i < count; i++) {
+            fn(i);
+        }
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        jobCount = count;
+        nextItem.store(0, std::memory_order_relaxed);
+        stealing = steal;
+        if (steal) {
+            size_t participants = size();
+            for (size_t i = 0; i < participants; i++) {
+                uint32_t begin = static_cast<uint32_t>(count * i / participants);
+                uint32_t end = static_cast<uint32_t>(count * (i + 1) / participants);
+                ranges[i].range.store(packRange(begin, end), std::memory_order_relaxed);
+            }
+        }
+        busyWorkers = workers.size();
+        generation++;
+    }
+    wakeCondition.notify_all();
+    
+    insidePool = true;
+    drain(0);
+    insidePool = false;
+    
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [&] { return busyWorkers == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+    
+    size_t chunks = (count + grain - 1) / grain;
+    run(chunks, [&](size_t chunk) {
+        size_t begin = chunk * grain;
+        size_t end = std::min(begin + grain, count);
+        fn(begin, end);
+    });
+}
+
+ThreadPool& ThreadPool::global() {
+    static ThreadPool pool;
+    return pool;
+}
\ No newline at end of file
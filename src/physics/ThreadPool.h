@@ -0,0 +1,53 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+private:
+    struct alignas(64) StealRange {
+        std::atomic<uint64_t> range;
+    };
+    
+    std::vector<std::thread> workers;
+    std::unique_ptr<StealRange[]> ranges;
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+    
+    const std::function<void(size_t)>* job;
+    size_t jobCount;
+    std::atomic<size_t> nextItem;
+    size_t generation;
+    size_t busyWorkers;
+    bool stopping;
+    bool stealing;
+    
+    void workerLoop(size_t index);
+    void drain(size_t index);
+    void drainStealing(size_t index);
+    bool popRange(size_t index, size_t& item);
+    bool stealRange(size_t victim, uint32_t& begin, uint32_t& end);
+    void dispatch(size_t count, const std::function<void(size_t)>& fn, bool steal);
+    
+public:
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    size_t size() const { return workers.size() + 1; }
+    
+    void run(size_t count, const std::function<void(size_t)>& fn);
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+    void runStealing(size_t count, const std::function<void(size_t)>& fn);
+    
+    static ThreadPool& global();
+};
\ No newline at end of file
@@ -1,9 +1,17 @@
 #include "PhysicsWorld.h"
 
+static const int gridCellSize = 50;
+
 PhysicsWorld::PhysicsWorld(int screenWidth, int screenHeight)
-    : screenWidth(screenWidth), screenHeight(screenHeight), 
-      useCollisions(false), constraintIterations(3) {
-    spatialGrid = std::make_unique<SpatialGrid>(screenWidth, screenHeight, 50);
+    : spatialQuery(screenWidth, screenHeight, static_cast<float>(gridCellSize)),
+      staticColliders(nullptr),
+      screenWidth(screenWidth), screenHeight(screenHeight), 
+      useCollisions(false), constraintIterations(3),
+      integrationMode(IntegrationMode::EXPLICIT_EULER), substeps(1),
+      queryIndexEnabled(false), reorderInterval(0), stepsSinceReorder(0),
+      adaptiveTimestep(false), incrementalGrid(false),
+      integrator(&PhysicsWorld::integrateWith<SymplecticEuler>) {
+    spatialGrid = std::make_unique<SpatialGrid>(screenWidth, screenHeight, gridCellSize);
     collisionResolver = std::make_unique<CollisionResolver>(0.7f);
 }
 
@@ -11,12 +19,131 @@ void PhysicsWorld::addParticle(const Particle& particle) {
     particles.push_back(particle);
 }
 
+void PhysicsWorld::loadScene(const SceneFile& scene) {
+    const SceneHeader& header = scene.getHeader();
+    clear();
+    forceGenerators.clear();
+    
+    const SceneParticle* records = scene.getParticles();
+    particles.resize(header.particleCount);
+    ThreadPool::global().parallelFor(particles.size(), 16384, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const SceneParticle& r = records[i];
+            Particle& p = particles[i];
+            p.position = Vector2(r.x, r.y);
+            p.velocity = Vector2(r.vx, r.vy);
+            p.radius = r.radius;
+            p.setMass(r.mass);
+        }
+    });
+    
+    const SceneConstraint* constraintRecords = scene.getConstraints();
+    size_t typeCounts[4] = { 0, 0, 0, 0 };
+    for (uint32_t i = 0; i < header.constraintCount; i++) {
+        typeCounts[static_cast<uint32_t>(constraintRecords[i].type)]++;
+    }
+    constraintStore.getDistanceConstraints().reserve(typeCounts[0]);
+    constraintStore.getSpringConstraints().reserve(typeCounts[1]);
+    constraintStore.getPinConstraints().reserve(typeCounts[2]);
+    constraintStore.getAngleConstraints().reserve(typeCounts[3]);
+    
+    for (uint32_t i = 0; i < header.constraintCount; i++) {
+        const SceneConstraint& c = constraintRecords[i];
+        Particle* a = &particles[c.a];
+        switch (c.type) {
+            case SceneConstraintType::DISTANCE:
+                constraintStore.add(DistanceConstraint(a, &particles[c.b], c.params[0], c.params[1]));
+                break;
+            case SceneConstraintType::SPRING:
+                constraintStore.add(SpringConstraint(a, &particles[c.b], c.params[0], c.params[1], c.params[2]));
+                break;
+            case SceneConstraintType::PIN:
+                constraintStore.add(PinConstraint(a, Vector2(c.params[0], c.params[1]), c.params[2]));
+                break;
+            case SceneConstraintType::ANGLE:
+                constraintStore.add(AngleConstraint(a, &particles[c.b], &particles[c.c], c.params[0], c.params[1]));
+                break;
+        }
+    }
+    
+    const SceneForce* forces = scene.getForces();
+    for (uint32_t i = 0; i < header.forceCount; i++) {
+        const float* f = forces[i].params;
+        switch (forces[i].type) {
+            case SceneForceType::GRAVITY:
+                forceGenerators.push_back(std::make_shared<GravityForce>(Vector2(f[0], f[1])));
+                break;
+            case SceneForceType::DRAG:
+                forceGenerators.push_back(std::make_shared<DragForce>(f[0], f[1]));
+                break;
+            case SceneForceType::WIND:
+                forceGenerators.push_back(std::make_shared<WindForce>(Vector2(f[0], f[1]), f[2]));
+                break;
+            case SceneForceType::ATTRACTOR:
+                forceGenerators.push_back(std::make_shared<AttractorForce>(Vector2(f[0], f[1]), f[2], f[3]));
+                break;
+            case SceneForceType::FRICTION:
+                forceGenerators.push_back(std::make_shared<FrictionForce>(f[0]));
+                break;
+        }
+    }
+}
+
 void PhysicsWorld::addForceGenerator(std::shared_ptr<ForceGenerator> generator) {
-    forceGenerators.push_back(generator);
+    forceGenerators.push_back(std::move(generator));
 }
 
 void PhysicsWorld::addConstraint(std::shared_ptr<Constraint> constraint) {
-    constraints.push_back(constraint);
+    if (auto* spring = dynamic_cast<SpringConstraint*>(constraint.get())) {
+        constraintStore.add(*spring);
+    } else if (auto* distance = dynamic_cast<DistanceConstraint*>(constraint.get())) {
+        constraintStore.add(*distance);
+    } else if (auto* pin = dynamic_cast<PinConstraint*>(constraint.get())) {
+        constraintStore.add(*pin);
+    } else if (auto* angle = dynamic_cast<AngleConstraint*>(constraint.get())) {
+        constraintStore.add(*angle);
+    } else {
+        constraints.push_back(std::move(constraint));
+    }
+}
+
+void PhysicsWorld::registerKnobs(FrameGovernor& governor) {
+    if (collisionResolver->getSolverMode() == ContactSolverMode::JACOBI) {
+        JacobiContactSolver& jacobi = collisionResolver->getJacobiSolver();
+        float passes = static_cast<float>(jacobi.getIterations());
+        governor.addKnob("particle.contactPasses", passes, 1.0f, passes, 1.0f, [&jacobi](float value) {
+            jacobi.setIterations(static_cast<int>(value));
+        });
+    }
+    
+    float iterations = static_cast<float>(constraintIterations);
+    governor.addKnob("particle.constraintIterations", iterations, 1.0f, iterations, 1.0f, [this](float value) {
+        constraintIterations = static_cast<int>(value);
+    });
+    
+    float steps = static_cast<float>(substeps);
+    governor.addKnob("particle.substeps", steps, 1.0f, steps, 1.0f, [this](float value) {
+        setSubsteps(static_cast<int>(value));
+    });
+}
+
+void PhysicsWorld::setHierarchicalGridEnabled(bool enabled) {
+    if (!enabled) {
+        hierarchicalGrid.reset();
+    } else if (!hierarchicalGrid) {
+        hierarchicalGrid = std::make_unique<HierarchicalGrid>(static_cast<float>(screenWidth),
+                                                              static_cast<float>(screenHeight));
+    }
+}
+
+void PhysicsWorld::setIncrementalGridEnabled(bool enabled) {
+    incrementalGrid = enabled;
+    spatialGrid->invalidate();
+    pairCache.invalidate();
+}
+
+void PhysicsWorld::enableFluid(const SPHParameters& params) {
+    fluidSolver = std::make_unique<SPHSolver>(screenWidth, screenHeight, params);
 }
 
 void PhysicsWorld::applyForces(float dt) {
@@ -25,10 +152,23 @@ void PhysicsWorld::applyForces(float dt) {
             generator->applyForce(particle, dt);
         }
     }
+    
+    if (fluidSolver) {
+        fluidSolver->computeForces(particles, ThreadPool::global());
+    }
+}
+
+void PhysicsWorld::applyForces(size_t begin, size_t end, float dt) {
+    for (size_t i = begin; i < end; i++) {
+        for (auto& generator : forceGenerators) {
+            generator->applyForce(particles[i], dt);
+        }
+    }
 }
 
 void PhysicsWorld::solveConstraints() {
     for (int i = 0; i < constraintIterations; i++) {
+        constraintStore.solve();
         for (auto& constraint : constraints) {
             constraint->solve();
         }
@@ -38,12 +178,84 @@ void PhysicsWorld::solveConstraints() {
 void PhysicsWorld::detectAndResolveCollisions() {
     if (!useCollisions || particles.size() < 2) return;
     
+    updateBroadphase();
+    resolveCollisions();
+}
+
+void PhysicsWorld::updateBroadphase() {
+    if (!useCollisions || particles.size() < 2) return;
+    
+    if (hierarchicalGrid) {
+        hierarchicalGrid->build(particles);
+        return;
+    }
+    
+    if (incrementalGrid) {
+        spatialGrid->update(particles);
+        pairCache.refresh(*spatialGrid, particles);
+        return;
+    }
+    
+    if (neighborList.getSkin() > 0.0f) {
+        if (neighborList.needsRebuild(particles)) {
+            neighborList.build(particles, *spatialGrid);
+        }
+        return;
+    }
+    
     spatialGrid->clear();
     for (auto& particle : particles) {
         spatialGrid->insert(particle);
     }
+}
+
+void PhysicsWorld::resolveCollisions() {
+    generateContacts();
+    if (contacts.empty()) return;
+    collisionResolver->resolveContacts(contacts, particles, ThreadPool::global());
+}
+
+void PhysicsWorld::generateContacts() {
+    contacts.clear();
+    if (!useCollisions || particles.size() < 2) return;
+    
+    if (hierarchicalGrid) {
+        for (size_t i = 0; i < particles.size(); i++) {
+            hierarchicalGrid->forEachCandidate(particles, static_cast<uint32_t>(i), [&](uint32_t j) {
+                Contact* contact = CollisionDetector::generateContact(particles[i], particles[j]);
+                if (contact) {
+                    contacts.push_back(*contact);
+                    delete contact;
+                }
+            });
+        }
+        return;
+    }
+    
+    if (incrementalGrid) {
+        pairCache.forEachPair([&](uint32_t a, uint32_t b) {
+            Contact* contact = CollisionDetector::generateContact(particles[a], particles[b]);
+            if (contact) {
+                contacts.push_back(*contact);
+                delete contact;
+            }
+        });
+        return;
+    }
     
-    std::vector<Contact> contacts;
+    if (neighborList.getSkin() > 0.0f) {
+        for (size_t i = 0; i < particles.size(); i++) {
+            for (uint32_t slot = neighborList.begin(i); slot < neighborList.end(i); slot++) {
+                Contact* contact = CollisionDetector::generateContact(
+                    particles[i], particles[neighborList.neighbor(slot)]);
+                if (contact) {
+                    contacts.push_back(*contact);
+                    delete contact;
+                }
+            }
+        }
+        return;
+    }
     
     for (size_t i = 0; i < particles.size(); i++) {
         auto nearby = spatialGrid->query(particles[i]);
@@ -58,12 +270,15 @@ void PhysicsWorld::detectAndResolveCollisions() {
             }
         }
     }
-    
-    collisionResolver->resolveContacts(contacts);
 }
 
 void PhysicsWorld::applyBoundaryConstraints() {
-    for (auto& particle : particles) {
+    applyBoundaryConstraints(0, particles.size());
+}
+
+void PhysicsWorld::applyBoundaryConstraints(size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        Particle& particle = particles[i];
         if (particle.position.y + particle.radius > screenHeight) {
             particle.position.y = screenHeight - particle.radius;
             particle.velocity.y *= -0.6f;
@@ -83,19 +298,366 @@ void PhysicsWorld::applyBoundaryConstraints() {
             particle.position.x = particle.radius;
             particle.velocity.x *= -0.6f;
         }
+        
+        if (staticColliders && !particle.hasInfiniteMass()) {
+            Vector2 center = particle.position;
+            staticColliders->queryCircle(center, particle.radius, [&](const StaticContact& contact) {
+                particle.position += contact.normal * contact.penetration;
+                float normalVelocity = particle.velocity.dot(contact.normal);
+                if (normalVelocity < 0.0f) {
+                    float restitution = staticColliders->getShape(contact.shape).restitution;
+                    particle.velocity -= contact.normal * (normalVelocity * (1.0f + restitution));
+                }
+            });
+        }
     }
 }
 
-void PhysicsWorld::update(float dt) {
+void PhysicsWorld::updateXPBD(float dt) {
     applyForces(dt);
     
+    float h = dt / substeps;
+    previousPositions.resize(particles.size());
+    
+    for (int step = 0; step < substeps; step++) {
+        for (size_t i = 0; i < particles.size(); i++) {
+            previousPositions[i] = particles[i].position;
+            particles[i].predict(h);
+        }
+        
+        constraintStore.resetLambda();
+        for (auto& constraint : constraints) {
+            constraint->resetLambda();
+        }
+        for (int i = 0; i < constraintIterations; i++) {
+            constraintStore.solvePositions(h);
+            for (auto& constraint : constraints) {
+                constraint->solvePositions(h);
+            }
+        }
+        
+        for (size_t i = 0; i < particles.size(); i++) {
+            if (particles[i].hasInfiniteMass()) continue;
+            particles[i].velocity = (particles[i].position - previousPositions[i]) / h;
+        }
+        
+        detectAndResolveCollisions();
+        
+        applyBoundaryConstraints();
+    }
+    
     for (auto& particle : particles) {
-        particle.integrate(dt);
+        particle.clearForces();
+    }
+}
+
+void PhysicsWorld::rebuildSpatialQuery(const std::vector<RigidBody>* bodies) {
+    spatialQuery.build(particles, bodies);
+}
+
+void PhysicsWorld::rebuildSpatialQuery(const std::vector<Vector2>& bodyPositions,
+                                       const std::vector<float>& bodyOrientations,
+                                       const std::vector<RigidBodyMaterial>& bodyMaterials) {
+    spatialQuery.build(particles, bodyPositions, bodyOrientations, bodyMaterials);
+}
+
+void PhysicsWorld::exportQuantized(QuantizedParticles& out, float maxSpeed) const {
+    out.encode(particles, Vector2(0, 0), Vector2(static_cast<float>(screenWidth), static_cast<float>(screenHeight)),
+               maxSpeed, ThreadPool::global());
+}
+
+void PhysicsWorld::renderConstraints(Renderer& renderer) {
+    constraintStore.render(renderer);
+    for (auto& constraint : constraints) {
+        constraint->render(renderer);
+    }
+}
+
+void PhysicsWorld::reorderParticles() {
+    if (particles.size() < 2) return;
+    
+    ParticleRemap remap = particleReorder.reorder(particles, static_cast<float>(gridCellSize),
+                                                  ThreadPool::global());
+    
+    constraintStore.remapParticles(remap);
+    for (auto& constraint : constraints) {
+        constraint->remapParticles(remap);
     }
     
+    if (syncSpringForces.size() == particles.size()) {
+        const std::vector<uint32_t>& newIndex = particleReorder.getNewIndex();
+        externalForces.resize(syncSpringForces.size());
+        for (size_t i = 0; i < syncSpringForces.size(); i++) {
+            externalForces[newIndex[i]] = syncSpringForces[i];
+        }
+        syncSpringForces.swap(externalForces);
+    }
+    
+    neighborList.invalidate();
+    implicitSolver.invalidate();
+    spatialGrid->invalidate();
+}
+
+void PhysicsWorld::update(float dt) {
+    if (reorderInterval > 0 && ++stepsSinceReorder >= reorderInterval) {
+        reorderParticles();
+        stepsSinceReorder = 0;
+    }
+    
+    if (integrationMode == IntegrationMode::XPBD) {
+        updateXPBD(dt);
+    } else if (integrationMode == IntegrationMode::IMPLICIT_SPRINGS) {
+        updateImplicit(dt);
+    } else if (adaptiveTimestep) {
+        updateAdaptive(dt);
+    } else {
+        updateExplicit(dt);
+    }
+    
+    if (queryIndexEnabled) {
+        rebuildSpatialQuery();
+    }
+}
+
+void PhysicsWorld::updateExplicit(float dt) {
+    applyForces(dt);
+    
+    integrate(0, particles.size(), dt);
+    
     solveConstraints();
     
     detectAndResolveCollisions();
     
     applyBoundaryConstraints();
+}
+
+void PhysicsWorld::updateImplicit(float dt) {
+    applyForces(dt);
+    
+    implicitSolver.step(particles, constraintStore.getSpringConstraints(), dt, ThreadPool::global());
+    
+    integrate(0, particles.size(), dt);
+    
+    for (int i = 0; i < constraintIterations; i++) {
+        solvePositionalConstraints();
+    }
+    
+    detectAndResolveCollisions();
+    
+    applyBoundaryConstraints();
+}
+
+void PhysicsWorld::solvePositionalConstraints() {
+    for (auto& c : constraintStore.getDistanceConstraints()) c.solve();
+    for (auto& c : constraintStore.getPinConstraints()) c.solve();
+    for (auto& c : constraintStore.getAngleConstraints()) c.solve();
+    for (auto& constraint : constraints) {
+        constraint->solve();
+    }
+}
+
+void PhysicsWorld::updateAdaptive(float dt) {
+    float remaining = dt;
+    while (remaining > 0.0f) {
+        float step = timestepController.plan(particles, constraintStore.getSpringConstraints(), remaining);
+        stepMultiRate(step);
+        remaining -= step;
+    }
+}
+
+void PhysicsWorld::stepMultiRate(float dt) {
+    applyForces(dt);
+    
+    bool substepCollisions = useCollisions && particles.size() >= 2 && timestepController.getActiveLevels() > 1;
+    if (substepCollisions) spatialGrid->update(particles);
+    
+    std::vector<SpringConstraint>& springs = constraintStore.getSpringConstraints();
+    for (int level = 1; level < timestepController.getActiveLevels(); level++) {
+        const uint32_t* indices = timestepController.getLevelParticles(level);
+        size_t count = timestepController.getLevelSize(level);
+        const uint32_t* springIndices = timestepController.getLevelSprings(level);
+        size_t springCount = timestepController.getLevelSpringCount(level);
+        if (count == 0) continue;
+        
+        externalForces.resize(count);
+        for (size_t k = 0; k < count; k++) {
+            uint32_t i = indices[k];
+            externalForces[k] = particles[i].forceAccumulator;
+            if (i < syncSpringForces.size()) externalForces[k] -= syncSpringForces[i];
+        }
+        
+        int steps = 1 << level;
+        float h = dt / static_cast<float>(steps);
+        for (int step = 0; step < steps; step++) {
+            for (size_t k = 0; k < count; k++) {
+                particles[indices[k]].forceAccumulator = externalForces[k];
+            }
+            for (size_t k = 0; k < springCount; k++) {
+                springs[springIndices[k]].solve();
+            }
+            (this->*integrator)(indices, 0, count, h);
+            if (substepCollisions) collideSubstep(level, indices, count);
+        }
+    }
+    
+    const uint32_t* indices = timestepController.getLevelParticles(0);
+    size_t count = timestepController.getLevelSize(0);
+    (this->*integrator)(indices, 0, count, dt);
+    
+    solveSyncConstraints();
+    
+    detectAndResolveCollisions();
+    
+    applyBoundaryConstraints();
+}
+
+void PhysicsWorld::collideSubstep(int level, const uint32_t* indices, size_t count) {
+    const Particle* base = particles.data();
+    for (size_t k = 0; k < count; k++) {
+        Particle& particle = particles[indices[k]];
+        spatialGrid->query(particle, substepCandidates);
+        
+        for (Particle* other : substepCandidates) {
+            if (other == &particle) continue;
+            if (other < &particle && timestepController.getLevel(other - base) == level) continue;
+            
+            Contact* contact = CollisionDetector::generateContact(particle, *other);
+            if (contact) {
+                collisionResolver->resolveContact(*contact);
+                delete contact;
+            }
+        }
+        
+        applyBoundaryConstraints(indices[k], indices[k] + 1);
+    }
+}
+
+void PhysicsWorld::solveSyncConstraints() {
+    std::vector<SpringConstraint>& springs = constraintStore.getSpringConstraints();
+    const uint32_t* springIndices = timestepController.getLevelSprings(0);
+    size_t springCount = timestepController.getLevelSpringCount(0);
+    const Particle* base = particles.data();
+    
+    syncSpringForces.assign(particles.size(), Vector2(0, 0));
+    for (int i = 0; i < constraintIterations; i++) {
+        for (size_t k = 0; k < springCount; k++) {
+            SpringConstraint& spring = springs[springIndices[k]];
+            Particle* a = spring.getParticleA();
+            Particle* b = spring.getParticleB();
+            Vector2 beforeA = a->forceAccumulator;
+            Vector2 beforeB = b->forceAccumulator;
+            spring.solve();
+            syncSpringForces[a - base] += a->forceAccumulator - beforeA;
+            syncSpringForces[b - base] += b->forceAccumulator - beforeB;
+        }
+        solvePositionalConstraints();
+    }
+}
+
+void PhysicsWorld::buildStepGraph(TaskGraph& graph, float dt) {
+    if (reorderInterval > 0 && ++stepsSinceReorder >= reorderInterval) {
+        reorderParticles();
+        stepsSinceReorder = 0;
+    }
+    
+    if (integrationMode == IntegrationMode::XPBD) {
+        graph.addTask("particle.xpbd", RESOURCE_PARTICLE_STATE | RESOURCE_PARTICLE_FORCES,
+                      RESOURCE_PARTICLE_STATE | RESOURCE_PARTICLE_FORCES | RESOURCE_PARTICLE_GRID,
+                      [this, dt] { updateXPBD(dt); });
+    } else if (integrationMode == IntegrationMode::IMPLICIT_SPRINGS) {
+        graph.addTask("particle.implicit", RESOURCE_PARTICLE_STATE | RESOURCE_PARTICLE_FORCES,
+                      RESOURCE_PARTICLE_STATE | RESOURCE_PARTICLE_FORCES | RESOURCE_PARTICLE_GRID,
+                      [this, dt] { updateImplicit(dt); });
+    } else if (adaptiveTimestep) {
+        graph.addTask("particle.adaptive", RESOURCE_PARTICLE_STATE | RESOURCE_PARTICLE_FORCES,
+                      RESOURCE_PARTICLE_STATE | RESOURCE_PARTICLE_FORCES | RESOURCE_PARTICLE_GRID,
+                      [this, dt] { updateAdaptive(dt); });
+    } else {
+        buildExplicitGraph(graph, dt);
+    }
+    
+    if (queryIndexEnabled) {
+        graph.addTask("particle.query", RESOURCE_PARTICLE_STATE, RESOURCE_QUERY_INDEX,
+                      [this] { rebuildSpatialQuery(); });
+    }
+}
+
+void PhysicsWorld::buildExplicitGraph(TaskGraph& graph, float dt) {
+    const size_t grain = 1024;
+    size_t count = particles.size();
+    bool hasConstraints = !constraintStore.empty() || !constraints.empty();
+    
+    graph.addChunkedTask("particle.forces", RESOURCE_PARTICLE_STATE, RESOURCE_PARTICLE_FORCES,
+                         count, grain, [this, dt](size_t begin, size_t end) {
+                             applyForces(begin, end, dt);
+                         });
+    
+    if (fluidSolver) {
+        SPHSolver* fluid = fluidSolver.get();
+        graph.addDynamicTask("particle.fluid.gather", RESOURCE_PARTICLE_STATE, RESOURCE_PARTICLE_FORCES,
+                             SPHSolver::CHUNK_SIZE, [this, fluid] { return fluid->beginStep(particles); },
+                             [this, fluid](size_t begin, size_t end) { fluid->gatherState(particles, begin, end); });
+        graph.addDynamicTask("particle.fluid.neighbors", RESOURCE_PARTICLE_STATE, RESOURCE_PARTICLE_FORCES, 1,
+                             [this, fluid] { return fluid->beginNeighborSearch(particles); },
+                             [this, fluid](size_t begin, size_t end) { fluid->findNeighbors(particles, begin, end); });
+        graph.addDynamicTask("particle.fluid.density", RESOURCE_PARTICLE_STATE, RESOURCE_PARTICLE_FORCES,
+                             SPHSolver::CHUNK_SIZE, [fluid] { return fluid->finishNeighborSearch(); },
+                             [fluid](size_t begin, size_t end) { fluid->computeDensity(begin, end); });
+        graph.addChunkedTask("particle.fluid.forces", RESOURCE_PARTICLE_STATE, RESOURCE_PARTICLE_FORCES,
+                             count, SPHSolver::CHUNK_SIZE, [this, fluid](size_t begin, size_t end) {
+                                 fluid->applyForces(particles, begin, end);
+                             });
+    }
+    
+    if (!hasConstraints && !useCollisions) {
+        graph.addPipeline("particle.integrate+boundaries", RESOURCE_PARTICLE_FORCES,
+                          RESOURCE_PARTICLE_STATE | RESOURCE_PARTICLE_FORCES, count, grain,
+                          { [this, dt](size_t begin, size_t end) { integrate(begin, end, dt); },
+                            [this](size_t begin, size_t end) { applyBoundaryConstraints(begin, end); } });
+    } else {
+        graph.addChunkedTask("particle.integrate", RESOURCE_PARTICLE_FORCES,
+                             RESOURCE_PARTICLE_STATE | RESOURCE_PARTICLE_FORCES, count, grain,
+                             [this, dt](size_t begin, size_t end) { integrate(begin, end, dt); });
+        
+        if (hasConstraints) {
+            graph.addTask("particle.constraints", RESOURCE_PARTICLE_STATE,
+                          RESOURCE_PARTICLE_STATE | RESOURCE_PARTICLE_FORCES,
+                          [this] { solveConstraints(); });
+        }
+        
+        if (useCollisions) {
+            graph.addTask("particle.broadphase", RESOURCE_PARTICLE_STATE, RESOURCE_PARTICLE_GRID,
+                          [this] { updateBroadphase(); });
+            if (collisionResolver->getSolverMode() == ContactSolverMode::JACOBI) {
+                buildJacobiGraph(graph);
+            } else {
+                graph.addTask("particle.contacts", RESOURCE_PARTICLE_GRID, RESOURCE_PARTICLE_STATE,
+                              [this] { resolveCollisions(); });
+            }
+        }
+        
+        graph.addChunkedTask("particle.boundaries", 0, RESOURCE_PARTICLE_STATE, count, grain,
+                             [this](size_t begin, size_t end) { applyBoundaryConstraints(begin, end); });
+    }
+
+}
+
+void PhysicsWorld::buildJacobiGraph(TaskGraph& graph) {
+    JacobiContactSolver* jacobi = &collisionResolver->getJacobiSolver();
+    float restitution = collisionResolver->getRestitution();
+    
+    for (int iteration = 0; iteration < jacobi->getIterations(); iteration++) {
+        std::string suffix = "." + std::to_string(iteration);
+        graph.addDynamicTask("particle.contacts" + suffix, RESOURCE_PARTICLE_GRID, RESOURCE_PARTICLE_STATE,
+                             JacobiContactSolver::CONTACT_GRAIN, [this, jacobi, iteration] {
+                                 if (iteration > 0) return contacts.size();
+                                 generateContacts();
+                                 return jacobi->prepare(contacts, particles);
+                             }, [this, jacobi, restitution](size_t begin, size_t end) {
+                                 jacobi->computeDeltas(particles, restitution, begin, end);
+                             });
+        graph.addChunkedTask("particle.contacts.apply" + suffix, RESOURCE_PARTICLE_GRID, RESOURCE_PARTICLE_STATE,
+                             particles.size(), JacobiContactSolver::PARTICLE_GRAIN,
+                             [this, jacobi](size_t begin, size_t end) { jacobi->applyDeltas(particles, begin, end); });
+    }
 }
\ No newline at end of file
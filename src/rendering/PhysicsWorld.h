@@ -7,43 +7,156 @@
 #include "Collision.h"
 #include "CollisionResolver.h"
 #include "Constraint.h"
+#include "ConstraintStore.h"
+#include "SpatialQuery.h"
+#include "SPHSolver.h"
+#include "NeighborList.h"
+#include "ParticleReorder.h"
+#include "TaskGraph.h"
+#include "QuantizedParticles.h"
+#include "SceneFile.h"
+#include "AdaptiveTimestep.h"
+#include "StaticColliders.h"
+#include "ImplicitSpringSolver.h"
+#include "FrameGovernor.h"
+#include "HierarchicalGrid.h"
+#include "GridPairCache.h"
+
+enum class IntegrationMode {
+    EXPLICIT_EULER,
+    XPBD,
+    IMPLICIT_SPRINGS
+};
 
 class PhysicsWorld {
 private:
     std::vector<Particle> particles;
     std::vector<std::shared_ptr<ForceGenerator>> forceGenerators;
     std::vector<std::shared_ptr<Constraint>> constraints;
+    ConstraintStore constraintStore;
     std::unique_ptr<SpatialGrid> spatialGrid;
+    std::unique_ptr<HierarchicalGrid> hierarchicalGrid;
+    GridPairCache pairCache;
     std::unique_ptr<CollisionResolver> collisionResolver;
+    std::vector<Vector2> previousPositions;
+    SpatialQuery spatialQuery;
+    std::unique_ptr<SPHSolver> fluidSolver;
+    NeighborList neighborList;
+    ParticleReorder particleReorder;
+    std::vector<Contact> contacts;
+    AdaptiveTimestep timestepController;
+    ImplicitSpringSolver implicitSolver;
+    std::vector<Vector2> externalForces;
+    std::vector<Vector2> syncSpringForces;
+    std::vector<Particle*> substepCandidates;
+    const StaticColliders* staticColliders;
     
     int screenWidth;
     int screenHeight;
     bool useCollisions;
     int constraintIterations;
+    IntegrationMode integrationMode;
+    int substeps;
+    bool queryIndexEnabled;
+    int reorderInterval;
+    int stepsSinceReorder;
+    bool adaptiveTimestep;
+    bool incrementalGrid;
+    void (PhysicsWorld::*integrator)(const uint32_t*, size_t, size_t, float);
+    
+    void stepMultiRate(float dt);
+    void collideSubstep(int level, const uint32_t* indices, size_t count);
+    void solveSyncConstraints();
+    void solvePositionalConstraints();
     
 public:
     PhysicsWorld(int screenWidth, int screenHeight);
     
     void addParticle(const Particle& particle);
+    void loadScene(const SceneFile& scene);
     void addForceGenerator(std::shared_ptr<ForceGenerator> generator);
     void addConstraint(std::shared_ptr<Constraint> constraint);
+    size_t addConstraint(const DistanceConstraint& constraint) { return constraintStore.add(constraint); }
+    size_t addConstraint(const SpringConstraint& constraint) { return constraintStore.add(constraint); }
+    size_t addConstraint(const PinConstraint& constraint) { return constraintStore.add(constraint); }
+    size_t addConstraint(const AngleConstraint& constraint) { return constraintStore.add(constraint); }
     void update(float dt);
+    void registerKnobs(FrameGovernor& governor);
     
     void setCollisionsEnabled(bool enabled) { useCollisions = enabled; }
     void setRestitution(float e) { collisionResolver->setRestitution(e); }
+    void setContactSolverMode(ContactSolverMode mode) { collisionResolver->setSolverMode(mode); }
+    CollisionResolver& getCollisionResolver() { return *collisionResolver; }
     void setConstraintIterations(int iterations) { constraintIterations = iterations; }
+    int getConstraintIterations() const { return constraintIterations; }
+    void setIntegrationMode(IntegrationMode mode) { integrationMode = mode; }
+    void setSubsteps(int count) { substeps = count > 0 ? count : 1; }
+    int getSubsteps() const { return substeps; }
+    void setQueryIndexEnabled(bool enabled) { queryIndexEnabled = enabled; }
+    void enableFluid(const SPHParameters& params = SPHParameters());
+    void disableFluid() { fluidSolver.reset(); }
+    void setNeighborSkin(float skin) { neighborList.setSkin(skin); }
+    void setHierarchicalGridEnabled(bool enabled);
+    void setIncrementalGridEnabled(bool enabled);
+    const GridPairCache& getPairCache() const { return pairCache; }
+    const SpatialGrid& getSpatialGrid() const { return *spatialGrid; }
+    HierarchicalGrid* getHierarchicalGrid() { return hierarchicalGrid.get(); }
+    size_t getNeighborListRebuilds() const { return neighborList.getRebuildCount(); }
+    void setReorderInterval(int steps) { reorderInterval = steps; stepsSinceReorder = 0; }
+    const std::vector<uint32_t>& getLastReorderMap() const { return particleReorder.getNewIndex(); }
+    void setAdaptiveTimestep(bool enabled) { adaptiveTimestep = enabled; }
+    AdaptiveTimestep& getTimestepController() { return timestepController; }
+    void setStaticColliders(const StaticColliders* colliders) { staticColliders = colliders; }
+    ImplicitSpringSolver& getImplicitSolver() { return implicitSolver; }
     
     void applyForces(float dt);
     void solveConstraints();
     void applyBoundaryConstraints();
     void detectAndResolveCollisions();
+    void updateBroadphase();
+    void resolveCollisions();
+    void generateContacts();
+    void applyForces(size_t begin, size_t end, float dt);
+    void integrate(size_t begin, size_t end, float dt) { (this->*integrator)(nullptr, begin, end, dt); }
+    
+    template <typename Integrator>
+    void setIntegrator() { integrator = &PhysicsWorld::integrateWith<Integrator>; }
+    
+    template <typename Integrator>
+    void integrateWith(const uint32_t* indices, size_t begin, size_t end, float dt) {
+        for (size_t k = begin; k < end; k++) {
+            particles[indices ? indices[k] : k].integrateWith<Integrator>(dt);
+        }
+    }
+    void applyBoundaryConstraints(size_t begin, size_t end);
+    void buildStepGraph(TaskGraph& graph, float dt);
+    void buildExplicitGraph(TaskGraph& graph, float dt);
+    void buildJacobiGraph(TaskGraph& graph);
+    void updateExplicit(float dt);
+    void updateXPBD(float dt);
+    void updateAdaptive(float dt);
+    void updateImplicit(float dt);
+    void reorderParticles();
+    void rebuildSpatialQuery(const std::vector<RigidBody>* bodies = nullptr);
+    void rebuildSpatialQuery(const std::vector<Vector2>& bodyPositions, const std::vector<float>& bodyOrientations,
+                             const std::vector<RigidBodyMaterial>& bodyMaterials);
+    void exportQuantized(QuantizedParticles& out, float maxSpeed) const;
+    void renderConstraints(class Renderer& renderer);
     
     const std::vector<Particle>& getParticles() const { return particles; }
     std::vector<Particle>& getParticles() { return particles; }
     std::vector<std::shared_ptr<Constraint>>& getConstraints() { return constraints; }
+    ConstraintStore& getConstraintStore() { return constraintStore; }
+    const SpatialQuery& getSpatialQuery() const { return spatialQuery; }
+    SPHSolver* getFluidSolver() { return fluidSolver.get(); }
     
     void clear() { 
         particles.clear(); 
         constraints.clear();
+        constraintStore.clear();
+        neighborList.invalidate();
+        implicitSolver.invalidate();
+        spatialGrid->invalidate();
+        syncSpringForces.clear();
     }
 };
\ No newline at end of file
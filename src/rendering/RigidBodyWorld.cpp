@@ -0,0 +1,431 @@
+#include "RigidBodyWorld.h"
+#include <algorithm>
+#include <cmath>
+
+static const size_t bodyGrain = 256;
+static const size_t minParallelContacts = 64;
+
+RigidBodyWorld::RigidBodyWorld(int screenWidth, int screenHeight)
+    : staticColliders(nullptr), screenWidth(screenWidth), screenHeight(screenHeight), gravity(0, 400.0f),
+      gravityEnabled(true), solverIterations(2), removalMargin(200.0f),
+      detailEnabled(false), contactEventsEnabled(false), frame(0), contactPass(0),
+      integrator(&RigidBodyWorld::integrateWith<Damped<SymplecticEuler, 995, 950>>) {}
+
+size_t RigidBodyWorld::addBody(const RigidBody& body) {
+    positions.push_back(body.position);
+    velocities.push_back(body.velocity);
+    orientations.push_back(body.orientation);
+    angularVelocities.push_back(body.angularVelocity);
+    inverseMasses.push_back(body.hasInfiniteMass() ? 0.0f : body.inverseMass);
+    inverseInertias.push_back(body.hasInfiniteInertia() ? 0.0f : body.inverseInertia);
+    forces.push_back(body.forceAccumulator);
+    torques.push_back(body.torqueAccumulator);
+    extents.push_back(body.shapeType == ShapeType::CIRCLE
+        ? body.radius
+        : std::max(body.width, body.height) * 0.71f);
+    materials.push_back({ body.shapeType, body.radius, body.width, body.height,
+                          body.mass, body.inertia, body.restitution, body.friction });
+    detailTiers.push_back(DetailTier::FULL);
+    detailActive.push_back(1);
+    pendingTime.push_back(0.0f);
+    pendingImpulses.push_back(Vector2(0, 0));
+    pendingAngularImpulses.push_back(0.0f);
+    pendingFrames.push_back(0);
+    eventFlags.push_back(CONTACT_EVENTS_BEGIN | CONTACT_EVENTS_END);
+    return positions.size() - 1;
+}
+
+RigidBody RigidBodyWorld::getBody(size_t i) const {
+    const RigidBodyMaterial& m = materials[i];
+    RigidBody body;
+    body.position = positions[i];
+    body.velocity = velocities[i];
+    body.orientation = orientations[i];
+    body.angularVelocity = angularVelocities[i];
+    body.forceAccumulator = forces[i];
+    body.torqueAccumulator = torques[i];
+    body.mass = m.mass;
+    body.inverseMass = inverseMasses[i];
+    body.inertia = m.inertia;
+    body.inverseInertia = inverseInertias[i];
+    body.restitution = m.restitution;
+    body.friction = m.friction;
+    body.shapeType = m.shapeType;
+    body.radius = m.radius;
+    body.width = m.width;
+    body.height = m.height;
+    return body;
+}
+
+void RigidBodyWorld::clear() {
+    positions.clear();
+    velocities.clear();
+    orientations.clear();
+    angularVelocities.clear();
+    inverseMasses.clear();
+    inverseInertias.clear();
+    forces.clear();
+    torques.clear();
+    extents.clear();
+    materials.clear();
+    detailTiers.clear();
+    detailActive.clear();
+    pendingTime.clear();
+    pendingImpulses.clear();
+    pendingAngularImpulses.clear();
+    pendingFrames.clear();
+    eventFlags.clear();
+    contacts.clear();
+    contactEvents.clear();
+}
+
+void RigidBodyWorld::updateDetail() {
+    contactPass = 0;
+    frame++;
+    
+    if (!detailEnabled) {
+        std::fill(detailTiers.begin(), detailTiers.end(), DetailTier::FULL);
+        std::fill(detailActive.begin(), detailActive.end(), 1);
+        return;
+    }
+    
+    for (size_t i = 0; i < positions.size(); i++) {
+        DetailTier previous = detailTiers[i];
+        DetailTier tier = detail.classify(positions[i], extents[i], previous);
+        bool promoted = tier == DetailTier::FULL && previous != DetailTier::FULL;
+        detailTiers[i] = tier;
+        detailActive[i] = promoted || detail.isScheduled(tier, static_cast<uint32_t>(i), frame) ? 1 : 0;
+    }
+}
+
+bool RigidBodyWorld::skipPair(uint32_t a, uint32_t b, int pass) const {
+    if (!detailEnabled) return false;
+    if (!detailActive[a] && !detailActive[b]) return true;
+    return pass >= detail.getReducedIterations() &&
+           detailTiers[a] != DetailTier::FULL && detailTiers[b] != DetailTier::FULL;
+}
+
+void RigidBodyWorld::updateBroadphase() {
+    for (auto& bucket : buckets) {
+        bucket.clear();
+    }
+    
+    size_t n = positions.size();
+    sweep.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        float extent = extents[i];
+        sweep[i] = { positions[i].x - extent, positions[i].x + extent,
+                     positions[i].y - extent, positions[i].y + extent,
+                     static_cast<uint32_t>(i) };
+    }
+    
+    std::sort(sweep.begin(), sweep.end(), [](const SweepEntry& a, const SweepEntry& b) {
+        return a.minX < b.minX;
+    });
+    
+    for (size_t i = 0; i < sweep.size(); i++) {
+        const SweepEntry& a = sweep[i];
+        for (size_t j = i + 1; j < sweep.size() && sweep[j].minX <= a.maxX; j++) {
+            const SweepEntry& b = sweep[j];
+            if (a.maxY < b.minY || a.minY > b.maxY) continue;
+            if (skipPair(a.index, b.index, contactPass)) continue;
+            
+            ShapeType typeA = materials[a.index].shapeType;
+            ShapeType typeB = materials[b.index].shapeType;
+            ShapePair pair = RigidNarrowphase::classify(typeA, typeB);
+            
+            if (pair == ShapePair::CIRCLE_BOX && typeA == ShapeType::BOX) {
+                buckets[static_cast<int>(pair)].push_back({ b.index, a.index });
+            } else {
+                buckets[static_cast<int>(pair)].push_back({ a.index, b.index });
+            }
+        }
+    }
+}
+
+void RigidBodyWorld::generateContacts() {
+    contacts.clear();
+    RigidBodyContact contact;
+    
+    for (const BodyPair& pair : buckets[static_cast<int>(ShapePair::CIRCLE_CIRCLE)]) {
+        if (CollisionDetector::circleCircleContact(positions[pair.a], extents[pair.a],
+                                                   positions[pair.b], extents[pair.b],
+                                                   contact.contactPoint, contact.normal, contact.penetration)) {
+            contact.a = pair.a;
+            contact.b = pair.b;
+            contacts.push_back(contact);
+        }
+    }
+    
+    for (const BodyPair& pair : buckets[static_cast<int>(ShapePair::CIRCLE_BOX)]) {
+        const RigidBodyMaterial& box = materials[pair.b];
+        if (CollisionDetector::circleBoxContact(positions[pair.a], extents[pair.a], positions[pair.b],
+                                                orientations[pair.b], box.width, box.height,
+                                                contact.contactPoint, contact.normal, contact.penetration)) {
+            contact.a = pair.a;
+            contact.b = pair.b;
+            contacts.push_back(contact);
+        }
+    }
+    
+    for (const BodyPair& pair : buckets[static_cast<int>(ShapePair::BOX_BOX)]) {
+        const RigidBodyMaterial& a = materials[pair.a];
+        const RigidBodyMaterial& b = materials[pair.b];
+        if (CollisionDetector::boxBoxContact(positions[pair.a], std::max(a.width, a.height) * 0.5f,
+                                             positions[pair.b], std::max(b.width, b.height) * 0.5f,
+                                             contact.contactPoint, contact.normal, contact.penetration)) {
+            contact.a = pair.a;
+            contact.b = pair.b;
+            contacts.push_back(contact);
+        }
+    }
+}
+
+RigidBodyRef RigidBodyWorld::makeRef(uint32_t i) {
+    return { &positions[i], &velocities[i], &angularVelocities[i],
+             inverseMasses[i], inverseInertias[i], materials[i].restitution, materials[i].friction };
+}
+
+void RigidBodyWorld::resolveContact(const RigidBodyContact& contact) {
+    RigidBodyRef a = makeRef(contact.a);
+    RigidBodyRef b = makeRef(contact.b);
+    RigidBodyResolver::resolve(a, b, contact.contactPoint, contact.normal, contact.penetration);
+}
+
+size_t RigidBodyWorld::beginContactSolve(bool parallel) {
+    updateBroadphase();
+    generateContacts();
+    contactPass++;
+    
+    if (contactEventsEnabled) {
+        for (const auto& contact : contacts) {
+            contactEvents.record(contact.a, contact.b, contact.contactPoint, contact.normal, contact.penetration);
+        }
+    }
+    
+    if (!parallel || contacts.size() < minParallelContacts) {
+        for (const auto& contact : contacts) {
+            resolveContact(contact);
+        }
+        return 0;
+    }
+    
+    contactBodies.resize(contacts.size());
+    for (size_t k = 0; k < contacts.size(); k++) {
+        contactBodies[k] = { contacts[k].a, contacts[k].b };
+    }
+    
+    isStatic.resize(positions.size());
+    for (size_t i = 0; i < positions.size(); i++) {
+        isStatic[i] = inverseMasses[i] == 0.0f && inverseInertias[i] == 0.0f ? 1 : 0;
+    }
+    
+    islands.build(positions.size(), contactBodies, isStatic);
+    return islands.getIslandCount();
+}
+
+void RigidBodyWorld::solveIslands(size_t begin, size_t end) {
+    const std::vector<uint32_t>& order = islands.getIslandsBySize();
+    for (size_t i = begin; i < end; i++) {
+        uint32_t island = order[i];
+        const uint32_t* indices = islands.getIslandContacts(island);
+        size_t count = islands.getIslandSize(island);
+        for (size_t k = 0; k < count; k++) {
+            resolveContact(contacts[indices[k]]);
+        }
+    }
+}
+
+void RigidBodyWorld::applyBoundaryConstraints(size_t begin, size_t end) {
+    const float restitution = 0.5f;
+    
+    for (size_t i = begin; i < end; i++) {
+        const RigidBodyMaterial& m = materials[i];
+        float extent = m.shapeType == ShapeType::CIRCLE ? m.radius : std::max(m.width, m.height) * 0.7f;
+        Vector2& position = positions[i];
+        Vector2& velocity = velocities[i];
+        
+        if (position.y + extent > screenHeight) {
+            position.y = screenHeight - extent;
+            velocity.y *= -restitution;
+            velocity.x *= 0.95f;
+            angularVelocities[i] *= 0.95f;
+        }
+        
+        if (position.y - extent < 0) {
+            position.y = extent;
+            velocity.y *= -restitution;
+        }
+        
+        if (position.x - extent < 0) {
+            position.x = extent;
+            velocity.x *= -restitution;
+        }
+        if (position.x + extent > screenWidth) {
+            position.x = screenWidth - extent;
+            velocity.x *= -restitution;
+        }
+        
+        if (staticColliders && inverseMasses[i] != 0.0f && (!detailEnabled || detailActive[i])) {
+            collideStatic(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+void RigidBodyWorld::collideStatic(uint32_t i) {
+    RigidBodyRef body = makeRef(i);
+    Vector2 center = positions[i];
+    
+    staticColliders->queryCircle(center, extents[i], [&](const StaticContact& contact) {
+        const StaticShape& shape = staticColliders->getShape(contact.shape);
+        Vector2 groundPosition = contact.contactPoint;
+        Vector2 groundVelocity(0, 0);
+        float groundAngularVelocity = 0.0f;
+        RigidBodyRef ground = { &groundPosition, &groundVelocity, &groundAngularVelocity,
+                                0.0f, 0.0f, shape.restitution, shape.friction };
+        RigidBodyResolver::resolve(ground, body, contact.contactPoint, contact.normal, contact.penetration);
+    });
+}
+
+void RigidBodyWorld::setContactEventsEnabled(bool enabled) {
+    contactEventsEnabled = enabled;
+    contactEvents.clear();
+}
+
+void RigidBodyWorld::finishContactEvents() {
+    if (!contactEventsEnabled) return;
+    if (!detailEnabled) {
+        contactEvents.endStep(eventFlags.data());
+        return;
+    }
+    contactEvents.endStep(eventFlags.data(), [this](uint32_t a, uint32_t b) {
+        return skipPair(a, b, 0);
+    });
+}
+
+void RigidBodyWorld::removeOutOfBounds() {
+    float limit = screenHeight + removalMargin;
+    size_t write = 0;
+    
+    if (contactEventsEnabled) {
+        removalMap.resize(positions.size());
+        uint32_t kept = 0;
+        for (size_t i = 0; i < positions.size(); i++) {
+            removalMap[i] = positions[i].y > limit ? UINT32_MAX : kept++;
+        }
+        if (kept != positions.size()) contactEvents.remap(removalMap, eventFlags.data());
+    }
+    
+    for (size_t read = 0; read < positions.size(); read++) {
+        if (positions[read].y > limit) continue;
+        if (write != read) {
+            positions[write] = positions[read];
+            velocities[write] = velocities[read];
+            orientations[write] = orientations[read];
+            angularVelocities[write] = angularVelocities[read];
+            inverseMasses[write] = inverseMasses[read];
+            inverseInertias[write] = inverseInertias[read];
+            forces[write] = forces[read];
+            torques[write] = torques[read];
+            extents[write] = extents[read];
+            materials[write] = materials[read];
+            detailTiers[write] = detailTiers[read];
+            detailActive[write] = detailActive[read];
+            pendingTime[write] = pendingTime[read];
+            pendingImpulses[write] = pendingImpulses[read];
+            pendingAngularImpulses[write] = pendingAngularImpulses[read];
+            pendingFrames[write] = pendingFrames[read];
+            eventFlags[write] = eventFlags[read];
+        }
+        write++;
+    }
+    
+    if (write == positions.size()) return;
+    
+    positions.resize(write);
+    velocities.resize(write);
+    orientations.resize(write);
+    angularVelocities.resize(write);
+    inverseMasses.resize(write);
+    inverseInertias.resize(write);
+    forces.resize(write);
+    torques.resize(write);
+    extents.resize(write);
+    materials.resize(write);
+    detailTiers.resize(write);
+    detailActive.resize(write);
+    pendingTime.resize(write);
+    pendingImpulses.resize(write);
+    pendingAngularImpulses.resize(write);
+    pendingFrames.resize(write);
+    eventFlags.resize(write);
+    contacts.clear();
+}
+
+void RigidBodyWorld::registerKnobs(FrameGovernor& governor) {
+    float iterations = static_cast<float>(solverIterations);
+    governor.addKnob("rigid.solverIterations", iterations, 1.0f, iterations, 1.0f, [this](float value) {
+        solverIterations = static_cast<int>(value);
+    });
+    
+    const float minScale = 0.25f;
+    float fullMargin = detail.getFullMargin();
+    float reducedMargin = detail.getReducedMargin();
+    Vector2 screenMax(static_cast<float>(screenWidth), static_cast<float>(screenHeight));
+    if (!detailEnabled || !detail.hasInterest() || detail.covers(Vector2(0, 0), screenMax, fullMargin * minScale)) {
+        return;
+    }
+    governor.addKnob("rigid.detailScale", 1.0f, minScale, 1.0f, 0.25f, [this, fullMargin, reducedMargin](float scale) {
+        detail.setMargins(fullMargin * scale, reducedMargin * scale);
+    });
+}
+
+void RigidBodyWorld::update(float dt, ThreadPool& pool) {
+    bool parallel = pool.size() > 1;
+    
+    updateDetail();
+    
+    pool.parallelFor(size(), bodyGrain, [this, dt](size_t begin, size_t end) {
+        integrate(begin, end, dt);
+    });
+    
+    for (int iteration = 0; iteration < solverIterations; iteration++) {
+        size_t islandCount = beginContactSolve(parallel);
+        pool.run(islandCount, [this](size_t i) {
+            solveIslands(i, i + 1);
+        });
+    }
+    
+    pool.parallelFor(size(), bodyGrain, [this](size_t begin, size_t end) {
+        applyBoundaryConstraints(begin, end);
+    });
+    
+    finishContactEvents();
+    removeOutOfBounds();
+}
+
+void RigidBodyWorld::buildStepGraph(TaskGraph& graph, float dt) {
+    size_t count = size();
+    
+    graph.addTask("rigid.detail", RESOURCE_RIGID_STATE, RESOURCE_RIGID_FORCES, [this] { updateDetail(); });
+    
+    graph.addChunkedTask("rigid.integrate", RESOURCE_RIGID_FORCES, RESOURCE_RIGID_STATE | RESOURCE_RIGID_FORCES,
+                         count, bodyGrain, [this, dt](size_t begin, size_t end) {
+                             integrate(begin, end, dt);
+                         });
+    
+    for (int iteration = 0; iteration < solverIterations; iteration++) {
+        graph.addDynamicTask("rigid.contacts." + std::to_string(iteration), RESOURCE_RIGID_STATE,
+                             RESOURCE_RIGID_STATE | RESOURCE_RIGID_CONTACTS, 1,
+                             [this] { return beginContactSolve(true); },
+                             [this](size_t begin, size_t end) { solveIslands(begin, end); });
+    }
+    
+    graph.addChunkedTask("rigid.boundaries", 0, RESOURCE_RIGID_STATE, count, bodyGrain,
+                         [this](size_t begin, size_t end) { applyBoundaryConstraints(begin, end); });
+    
+    graph.addTask("rigid.events", RESOURCE_RIGID_CONTACTS, RESOURCE_RIGID_CONTACTS, [this] { finishContactEvents(); });
+    
+    graph.addTask("rigid.removal", 0, RESOURCE_RIGID_STATE | RESOURCE_RIGID_FORCES | RESOURCE_RIGID_CONTACTS,
+                  [this] { removeOutOfBounds(); });
+}
\ No newline at end of file
@@ -0,0 +1,205 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "Vector2.h"
+#include "RigidBody.h"
+#include "Collision.h"
+#include "RigidBodyResolver.h"
+#include "RigidNarrowphase.h"
+#include "ContactIslands.h"
+#include "ThreadPool.h"
+#include "TaskGraph.h"
+#include "SimulationLOD.h"
+#include "StaticColliders.h"
+#include "FrameGovernor.h"
+#include "ContactEvents.h"
+#include "Integrators.h"
+
+struct RigidBodyContact {
+    uint32_t a;
+    uint32_t b;
+    Vector2 contactPoint;
+    Vector2 normal;
+    float penetration;
+};
+
+class RigidBodyWorld {
+private:
+    std::vector<Vector2> positions;
+    std::vector<Vector2> velocities;
+    std::vector<float> orientations;
+    std::vector<float> angularVelocities;
+    std::vector<float> inverseMasses;
+    std::vector<float> inverseInertias;
+    std::vector<Vector2> forces;
+    std::vector<float> torques;
+    std::vector<float> extents;
+    std::vector<RigidBodyMaterial> materials;
+    std::vector<DetailTier> detailTiers;
+    std::vector<uint8_t> detailActive;
+    std::vector<float> pendingTime;
+    std::vector<Vector2> pendingImpulses;
+    std::vector<float> pendingAngularImpulses;
+    std::vector<uint32_t> pendingFrames;
+    std::vector<uint8_t> eventFlags;
+    
+    struct SweepEntry {
+        float minX;
+        float maxX;
+        float minY;
+        float maxY;
+        uint32_t index;
+    };
+    
+    std::vector<SweepEntry> sweep;
+    std::vector<BodyPair> buckets[static_cast<int>(ShapePair::COUNT)];
+    std::vector<RigidBodyContact> contacts;
+    std::vector<BodyPair> contactBodies;
+    std::vector<uint8_t> isStatic;
+    ContactIslands islands;
+    SimulationLOD detail;
+    ContactEvents contactEvents;
+    std::vector<uint32_t> removalMap;
+    const StaticColliders* staticColliders;
+    
+    int screenWidth;
+    int screenHeight;
+    Vector2 gravity;
+    bool gravityEnabled;
+    int solverIterations;
+    float removalMargin;
+    bool detailEnabled;
+    bool contactEventsEnabled;
+    uint64_t frame;
+    int contactPass;
+    void (RigidBodyWorld::*integrator)(size_t, size_t, float);
+    
+    RigidBodyRef makeRef(uint32_t i);
+    bool skipPair(uint32_t a, uint32_t b, int pass) const;
+    void collideStatic(uint32_t i);
+    void resolveContact(const RigidBodyContact& contact);
+    
+public:
+    RigidBodyWorld(int screenWidth, int screenHeight);
+    
+    size_t addBody(const RigidBody& body);
+    RigidBody getBody(size_t i) const;
+    size_t size() const { return positions.size(); }
+    bool empty() const { return positions.empty(); }
+    void clear();
+    
+    void addForce(size_t i, const Vector2& force) { forces[i] += force; }
+    void addTorque(size_t i, float torque) { torques[i] += torque; }
+    void setVelocity(size_t i, const Vector2& velocity) { velocities[i] = velocity; }
+    
+    void setGravity(const Vector2& g) { gravity = g; }
+    void setGravityEnabled(bool enabled) { gravityEnabled = enabled; }
+    bool isGravityEnabled() const { return gravityEnabled; }
+    void setSolverIterations(int iterations) { solverIterations = iterations; }
+    int getSolverIterations() const { return solverIterations; }
+    void setRemovalMargin(float margin) { removalMargin = margin; }
+    void setDetailEnabled(bool enabled) { detailEnabled = enabled; }
+    SimulationLOD& getDetail() { return detail; }
+    void setStaticColliders(const StaticColliders* colliders) { staticColliders = colliders; }
+    void setContactEventsEnabled(bool enabled);
+    void setContactEventFlags(size_t i, uint8_t flags) { eventFlags[i] = flags; }
+    ContactEvents& getContactEvents() { return contactEvents; }
+    
+    void registerKnobs(FrameGovernor& governor);
+    void update(float dt, ThreadPool& pool);
+    void buildStepGraph(TaskGraph& graph, float dt);
+    
+    void updateDetail();
+    void integrate(size_t begin, size_t end, float dt) { (this->*integrator)(begin, end, dt); }
+    
+    template <typename Integrator>
+    void setIntegrator() { integrator = &RigidBodyWorld::integrateWith<Integrator>; }
+    
+    template <typename Integrator>
+    void integrateWith(size_t begin, size_t end, float dt) {
+        float gx = gravityEnabled ? gravity.x : 0.0f;
+        float gy = gravityEnabled ? gravity.y : 0.0f;
+        
+        for (size_t i = begin; i < end; i++) {
+            float inverseMass = inverseMasses[i];
+            if (inverseMass == 0.0f) continue;
+            
+            float inverseInertia = inverseInertias[i];
+            float step = dt;
+            float impulseX = forces[i].x * inverseMass * dt;
+            float impulseY = forces[i].y * inverseMass * dt;
+            float angularImpulse = torques[i] * inverseInertia * dt;
+            uint32_t frames = 1;
+            forces[i].x = 0.0f;
+            forces[i].y = 0.0f;
+            torques[i] = 0.0f;
+            
+            if (detailEnabled) {
+                pendingTime[i] += dt;
+                pendingImpulses[i].x += impulseX;
+                pendingImpulses[i].y += impulseY;
+                pendingAngularImpulses[i] += angularImpulse;
+                pendingFrames[i]++;
+                if (!detailActive[i]) continue;
+                
+                step = pendingTime[i];
+                impulseX = pendingImpulses[i].x;
+                impulseY = pendingImpulses[i].y;
+                angularImpulse = pendingAngularImpulses[i];
+                frames = pendingFrames[i];
+                pendingTime[i] = 0.0f;
+                pendingImpulses[i].x = 0.0f;
+                pendingImpulses[i].y = 0.0f;
+                pendingAngularImpulses[i] = 0.0f;
+                pendingFrames[i] = 0;
+            }
+            if (step <= 0.0f) continue;
+            
+            Vector2& position = positions[i];
+            Vector2& velocity = velocities[i];
+            UniformField field(gx + impulseX / step, gy + impulseY / step);
+            Integrator::step(position.x, position.y, velocity.x, velocity.y, field, step);
+            if (frames > 1) {
+                float retain = IntegratorTraits<Integrator>::retain(frames - 1);
+                velocity.x *= retain;
+                velocity.y *= retain;
+            }
+            
+            if (velocity.x * velocity.x + velocity.y * velocity.y < 0.01f) {
+                velocity.x = 0;
+                velocity.y = 0;
+            }
+            
+            if (inverseInertia != 0.0f) {
+                float angularVelocity = angularVelocities[i] + angularImpulse;
+                angularVelocity *= IntegratorTraits<Integrator>::angularRetain(frames);
+                
+                if (std::abs(angularVelocity) < 0.05f) {
+                    angularVelocity = 0.0f;
+                }
+                
+                float maxAngularVelocity = 15.0f;
+                angularVelocity = std::max(-maxAngularVelocity, std::min(angularVelocity, maxAngularVelocity));
+                
+                angularVelocities[i] = angularVelocity;
+                orientations[i] += angularVelocity * step;
+            }
+        }
+    }
+    void updateBroadphase();
+    void generateContacts();
+    size_t beginContactSolve(bool parallel);
+    void solveIslands(size_t begin, size_t end);
+    void applyBoundaryConstraints(size_t begin, size_t end);
+    void finishContactEvents();
+    void removeOutOfBounds();
+    
+    const std::vector<Vector2>& getPositions() const { return positions; }
+    const std::vector<Vector2>& getVelocities() const { return velocities; }
+    const std::vector<float>& getOrientations() const { return orientations; }
+    const std::vector<RigidBodyMaterial>& getMaterials() const { return materials; }
+    const std::vector<RigidBodyContact>& getContacts() const { return contacts; }
+    const std::vector<DetailTier>& getDetailTiers() const { return detailTiers; }
+};
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "SharedState.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static bool isAbandoned(const std::string& shmName) {
+    SharedStateReader reader;
+    std::string ignored;
+    if (!reader.open(shmName, ignored)) return false;
+    
+    pid_t owner = static_cast<pid_t>(reader.getPublisher());
+    return owner > 0 && kill(owner, 0) != 0 && errno == ESRCH;
+}
+
+SharedStatePublisher::SharedStatePublisher()
+    : mapping(nullptr), mappingSize(0), header(nullptr), frame(0) {}
+
+SharedStatePublisher::~SharedStatePublisher() {
+    close();
+}
+
+bool SharedStatePublisher::open(const std::string& shmName, uint32_t maxParticles, uint32_t maxBodies,
+                                uint32_t slotCount, std::string& error) {
+    close();
+    if (slotCount < 2) slotCount = 2;
+    
+    size_t slotSize = sharedSlotSize(maxParticles, maxBodies);
+    size_t size = sharedHeaderSize() + slotSize * slotCount;
+    
+    int fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 && errno == EEXIST && isAbandoned(shmName)) {
+        shm_unlink(shmName.c_str());
+        fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    if (fd < 0) {
+        error = errno == EEXIST
+            ? "shared memory " + shmName + " is already in use"
+            : "cannot create shared memory " + shmName;
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        shm_unlink(shmName.c_str());
+        error = "cannot size shared memory " + shmName;
+        return false;
+    }
+    
+    mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        shm_unlink(shmName.c_str());
+        error = "cannot map shared memory " + shmName;
+        return false;
+    }
+    
+    name = shmName;
+    mappingSize = size;
+    frame = 0;
+    
+    std::memset(mapping, 0, size);
+    header = new (mapping) SharedStateHeader();
+    header->version = sharedStateVersion;
+    header->slotCount = slotCount;
+    header->slotSize = slotSize;
+    header->maxParticles = maxParticles;
+    header->maxBodies = maxBodies;
+    header->publisher = static_cast<uint64_t>(getpid());
+    header->latestFrame.store(0, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < slotCount; i++) {
+        new (slotAt(i)) SharedSlotHeader();
+        slotAt(i)->sequence.store(0, std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header->magic, sharedStateMagic, sizeof(sharedStateMagic));
+    return true;
+}
+
+void SharedStatePublisher::close() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+        shm_unlink(name.c_str());
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    header = nullptr;
+}
+
+SharedSlotHeader* SharedStatePublisher::slotAt(uint64_t index) {
+    char* base = static_cast<char*>(mapping) + sharedHeaderSize();
+    return reinterpret_cast<SharedSlotHeader*>(base + (index % header->slotCount) * header->slotSize);
+}
+
+void SharedStatePublisher::publish(const std::vector<Particle>* particles, const RigidBodyWorld* bodies,
+                                   double time) {
+    if (!header) return;
+    
+    frame++;
+    SharedSlotHeader* slot = slotAt(frame - 1);
+    char* data = reinterpret_cast<char*>(slot);
+    
+    slot->sequence.store(2 * frame - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    size_t particleTotal = particles ? particles->size() : 0;
+    size_t bodyTotal = bodies ? bodies->size() : 0;
+    uint32_t particleCount = static_cast<uint32_t>(std::min<size_t>(particleTotal, header->maxParticles));
+    uint32_t bodyCount = static_cast<uint32_t>(std::min<size_t>(bodyTotal, header->maxBodies));
+    
+    SharedParticle* outParticles = reinterpret_cast<SharedParticle*>(data + sharedParticleOffset());
+    for (uint32_t i = 0; i < particleCount; i++) {
+        const Particle& p = (*particles)[i];
+        outParticles[i] = { p.position.x, p.position.y, p.velocity.x, p.velocity.y, p.radius };
+    }
+    
+    SharedBody* outBodies = reinterpret_cast<SharedBody*>(data + sharedBodyOffset(header->maxParticles));
+    if (bodyCount > 0) {
+        const std::vector<Vector2>& positions = bodies->getPositions();
+        const std::vector<float>& orientations = bodies->getOrientations();
+        const std::vector<RigidBodyMaterial>& materials = bodies->getMaterials();
+        for (uint32_t i = 0; i < bodyCount; i++) {
+            const RigidBodyMaterial& m = materials[i];
+            outBodies[i] = { positions[i].x, positions[i].y, orientations[i],
+                             m.radius, m.width, m.height, static_cast<uint32_t>(m.shapeType) };
+        }
+    }
+    
+    slot->frame = frame;
+    slot->time = time;
+    slot->particleCount = particleCount;
+    slot->bodyCount = bodyCount;
+    slot->truncated = particleCount < particleTotal || bodyCount < bodyTotal;
+    
+    slot->sequence.store(2 * frame, std::memory_order_release);
+    header->latestFrame.store(frame, std::memory_order_release);
+}
\ No newline at end of file
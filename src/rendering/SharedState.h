@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Particle.h"
+#include "RigidBodyWorld.h"
+#include "SharedStateLayout.h"
+
+class SharedStatePublisher {
+private:
+    std::string name;
+    void* mapping;
+    size_t mappingSize;
+    SharedStateHeader* header;
+    uint64_t frame;
+    
+    SharedSlotHeader* slotAt(uint64_t index);
+    
+public:
+    SharedStatePublisher();
+    ~SharedStatePublisher();
+    SharedStatePublisher(const SharedStatePublisher&) = delete;
+    SharedStatePublisher& operator=(const SharedStatePublisher&) = delete;
+    
+    bool open(const std::string& name, uint32_t maxParticles, uint32_t maxBodies,
+              uint32_t slotCount, std::string& error);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+    
+    void publish(const std::vector<Particle>* particles, const RigidBodyWorld* bodies, double time);
+    
+    uint64_t getFrame() const { return frame; }
+};
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "SharedStateLayout.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared state needs lock-free 64-bit atomics");
+
+static const size_t slotAlignment = 64;
+
+static size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+size_t sharedHeaderSize() {
+    return alignUp(sizeof(SharedStateHeader), slotAlignment);
+}
+
+size_t sharedParticleOffset() {
+    return alignUp(sizeof(SharedSlotHeader), slotAlignment);
+}
+
+size_t sharedBodyOffset(uint32_t maxParticles) {
+    return alignUp(sharedParticleOffset() + maxParticles * sizeof(SharedParticle), slotAlignment);
+}
+
+size_t sharedSlotSize(uint32_t maxParticles, uint32_t maxBodies) {
+    return alignUp(sharedBodyOffset(maxParticles) + maxBodies * sizeof(SharedBody), slotAlignment);
+}
+
+SharedStateReader::SharedStateReader()
+    : mapping(nullptr), mappingSize(0), header(nullptr) {}
+
+SharedStateReader::~SharedStateReader() {
+    close();
+}
+
+bool SharedStateReader::open(const std::string& shmName, std::string& error) {
+    close();
+    
+    int fd = shm_open(shmName.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        error = "no shared state named " + shmName;
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sharedHeaderSize()) {
+        ::close(fd);
+        error = "shared state " + shmName + " is not initialised";
+        return false;
+    }
+    
+    mappingSize = static_cast<size_t>(info.st_size);
+    mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        mappingSize = 0;
+        error = "cannot map shared state " + shmName;
+        return false;
+    }
+    
+    header = static_cast<const SharedStateHeader*>(mapping);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (std::memcmp(header->magic, sharedStateMagic, sizeof(sharedStateMagic)) != 0 ||
+        header->version != sharedStateVersion ||
+        sharedHeaderSize() + header->slotSize * header->slotCount > mappingSize) {
+        close();
+        error = "shared state " + shmName + " has an unexpected layout";
+        return false;
+    }
+    return true;
+}
+
+void SharedStateReader::close() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    header = nullptr;
+}
+
+const SharedSlotHeader* SharedStateReader::slotAt(uint64_t index) const {
+    const char* base = static_cast<const char*>(mapping) + sharedHeaderSize();
+    return reinterpret_cast<const SharedSlotHeader*>(base + (index % header->slotCount) * header->slotSize);
+}
+
+uint64_t SharedStateReader::getLatestFrame() const {
+    return header ? header->latestFrame.load(std::memory_order_acquire) : 0;
+}
+
+bool SharedStateReader::latest(SharedFrame& out) const {
+    if (!header) return false;
+    
+    const int maxAttempts = 4;
+    for (int attempt = 0; attempt < maxAttempts; attempt++) {
+        uint64_t latestFrame = header->latestFrame.load(std::memory_order_acquire);
+        if (latestFrame == 0) return false;
+        
+        const SharedSlotHeader* slot = slotAt(latestFrame - 1);
+        uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * latestFrame) continue;
+        
+        const char* data = reinterpret_cast<const char*>(slot);
+        out.frame = slot->frame;
+        out.time = slot->time;
+        out.particleCount = std::min(slot->particleCount, header->maxParticles);
+        out.bodyCount = std::min(slot->bodyCount, header->maxBodies);
+        out.truncated = slot->truncated != 0;
+        out.particles = reinterpret_cast<const SharedParticle*>(data + sharedParticleOffset());
+        out.bodies = reinterpret_cast<const SharedBody*>(data + sharedBodyOffset(header->maxParticles));
+        out.slot = slot;
+        out.sequence = sequence;
+        
+        if (validate(out)) return true;
+    }
+    return false;
+}
+
+bool SharedStateReader::validate(const SharedFrame& frame) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return frame.slot->sequence.load(std::memory_order_relaxed) == frame.sequence;
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+static const uint32_t sharedStateVersion = 2;
+static const char sharedStateMagic[8] = { 'P', 'H', 'Y', 'S', 'S', 'H', 'M', '\0' };
+
+struct SharedParticle {
+    float x, y;
+    float vx, vy;
+    float radius;
+};
+
+struct SharedBody {
+    float x, y;
+    float orientation;
+    float radius;
+    float width, height;
+    uint32_t shape;
+};
+
+struct alignas(64) SharedSlotHeader {
+    std::atomic<uint64_t> sequence;
+    uint64_t frame;
+    double time;
+    uint32_t particleCount;
+    uint32_t bodyCount;
+    uint32_t truncated;
+};
+
+struct alignas(64) SharedStateHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t slotCount;
+    uint64_t slotSize;
+    uint32_t maxParticles;
+    uint32_t maxBodies;
+    uint64_t publisher;
+    std::atomic<uint64_t> latestFrame;
+};
+
+struct SharedFrame {
+    uint64_t frame;
+    double time;
+    uint32_t particleCount;
+    uint32_t bodyCount;
+    bool truncated;
+    const SharedParticle* particles;
+    const SharedBody* bodies;
+    
+    const SharedSlotHeader* slot;
+    uint64_t sequence;
+};
+
+size_t sharedHeaderSize();
+size_t sharedParticleOffset();
+size_t sharedBodyOffset(uint32_t maxParticles);
+size_t sharedSlotSize(uint32_t maxParticles, uint32_t maxBodies);
+
+class SharedStateReader {
+private:
+    void* mapping;
+    size_t mappingSize;
+    const SharedStateHeader* header;
+    
+    const SharedSlotHeader* slotAt(uint64_t index) const;
+    
+public:
+    SharedStateReader();
+    ~SharedStateReader();
+    SharedStateReader(const SharedStateReader&) = delete;
+    SharedStateReader& operator=(const SharedStateReader&) = delete;
+    
+    bool open(const std::string& name, std::string& error);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+    
+    bool latest(SharedFrame& out) const;
+    bool validate(const SharedFrame& frame) const;
+    
+    uint64_t getLatestFrame() const;
+    uint64_t getPublisher() const { return header ? header->publisher : 0; }
+};
\ No newline at end of file
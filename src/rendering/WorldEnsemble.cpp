@@ -0,0 +1,75 @@
+#include "WorldEnsemble.h"
+
+WorldEnsemble::WorldEnsemble()
+    : metricsPerWorld(0) {}
+
+PhysicsWorld& WorldEnsemble::addWorld(int screenWidth, int screenHeight) {
+    size_t index = addWorld(std::make_unique<PhysicsWorld>(screenWidth, screenHeight));
+    return *worlds[index];
+}
+
+size_t WorldEnsemble::addWorld(std::unique_ptr<PhysicsWorld> world) {
+    for (auto& generator : sharedForces) {
+        world->addForceGenerator(generator);
+    }
+    worlds.push_back(std::move(world));
+    return worlds.size() - 1;
+}
+
+void WorldEnsemble::addSharedForceGenerator(std::shared_ptr<ForceGenerator> generator) {
+    for (auto& world : worlds) {
+        world->addForceGenerator(generator);
+    }
+    sharedForces.push_back(std::move(generator));
+}
+
+void WorldEnsemble::setMetrics(size_t perWorld, std::function<void(size_t, const PhysicsWorld&, float*)> fn) {
+    metricsPerWorld = fn ? perWorld : 0;
+    metricFunction = std::move(fn);
+}
+
+void WorldEnsemble::collect(size_t index) {
+    const std::vector<Particle>& particles = worlds[index]->getParticles();
+    
+    float energy = 0.0f;
+    float totalMass = 0.0f;
+    Vector2 weighted(0, 0);
+    for (const auto& particle : particles) {
+        if (particle.hasInfiniteMass()) continue;
+        energy += 0.5f * particle.getMass() * particle.velocity.magnitudeSquared();
+        weighted += particle.position * particle.getMass();
+        totalMass += particle.getMass();
+    }
+    
+    kineticEnergy[index] = energy;
+    centerOfMass[index] = totalMass > 0.0f ? weighted / totalMass : Vector2(0, 0);
+    particleCounts[index] = static_cast<uint32_t>(particles.size());
+    
+    if (metricFunction) {
+        metricFunction(index, *worlds[index], metrics.data() + index * metricsPerWorld);
+    }
+}
+
+void WorldEnsemble::step(float dt, int steps, ThreadPool& pool) {
+    size_t count = worlds.size();
+    kineticEnergy.resize(count);
+    centerOfMass.resize(count);
+    particleCounts.resize(count);
+    metrics.resize(count * metricsPerWorld);
+    
+    pool.runStealing(count, [&](size_t i) {
+        PhysicsWorld& world = *worlds[i];
+        for (int s = 0; s < steps; s++) {
+            world.update(dt);
+        }
+        collect(i);
+    });
+}
+
+void WorldEnsemble::clear() {
+    worlds.clear();
+    kineticEnergy.clear();
+    centerOfMass.clear();
+    particleCounts.clear();
+    metrics.clear();
+}
\ No newline at end of file
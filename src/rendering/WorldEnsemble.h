@@ -0,0 +1,43 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <vector>
+#include "PhysicsWorld.h"
+#include "ThreadPool.h"
+
+class WorldEnsemble {
+private:
+    std::vector<std::unique_ptr<PhysicsWorld>> worlds;
+    std::vector<std::shared_ptr<ForceGenerator>> sharedForces;
+    
+    std::vector<float> kineticEnergy;
+    std::vector<Vector2> centerOfMass;
+    std::vector<uint32_t> particleCounts;
+    std::vector<float> metrics;
+    
+    std::function<void(size_t, const PhysicsWorld&, float*)> metricFunction;
+    size_t metricsPerWorld;
+    
+    void collect(size_t index);
+    
+public:
+    WorldEnsemble();
+    
+    PhysicsWorld& addWorld(int screenWidth, int screenHeight);
+    size_t addWorld(std::unique_ptr<PhysicsWorld> world);
+    void addSharedForceGenerator(std::shared_ptr<ForceGenerator> generator);
+    void setMetrics(size_t perWorld, std::function<void(size_t, const PhysicsWorld&, float*)> fn);
+    
+    void step(float dt, int steps, ThreadPool& pool);
+    
+    size_t size() const { return worlds.size(); }
+    PhysicsWorld& getWorld(size_t i) { return *worlds[i]; }
+    void clear();
+    
+    const std::vector<float>& getKineticEnergy() const { return kineticEnergy; }
+    const std::vector<Vector2>& getCenterOfMass() const { return centerOfMass; }
+    const std::vector<uint32_t>& getParticleCounts() const { return particleCounts; }
+    const std::vector<float>& getMetrics() const { return metrics; }
+    const float* getMetrics(size_t world) const { return metrics.data() + world * metricsPerWorld; }
+    size_t getMetricsPerWorld() const { return metricsPerWorld; }
+};
\ No newline at end of file
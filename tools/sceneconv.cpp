@@ -0,0 +1,41 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "SceneFile.h"
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <scene.txt> <scene.pscn>" << std::endl;
+        return 1;
+    }
+    
+    std::ifstream in(argv[1]);
+    if (!in) {
+        std::cerr << "cannot open " << argv[1] << std::endl;
+        return 1;
+    }
+    
+    SceneData scene;
+    std::string error;
+    if (!SceneFile::parseText(in, scene, error)) {
+        std::cerr << argv[1] << ": " << error << std::endl;
+        return 1;
+    }
+    
+    if (!SceneFile::write(argv[2], scene, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    
+    SceneFile check;
+    if (!check.open(argv[2], error)) {
+        std::cerr << argv[2] << ": " << error << std::endl;
+        return 1;
+    }
+    
+    std::cout << argv[2] << ": " << scene.particles.size() << " particles, "
+              << scene.rigidBodies.size() << " rigid bodies, "
+              << scene.constraints.size() << " constraints, "
+              << scene.forces.size() << " force generators" << std::endl;
+    return 0;
+}
\ No newline at end of file